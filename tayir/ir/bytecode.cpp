@@ -0,0 +1,1035 @@
+/**
+ * @file bytecode.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 二进制IR模块格式(.tbc)
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/bytecode.h>
+#include <utils/check.h>
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tayir {
+    /** 普通类型 */
+    static const byte TBC_TYPE_PLAIN = 0;
+    /** 复合类型 */
+    static const byte TBC_TYPE_COMPLEX = 1;
+
+    /** 操作数池ID */
+    static const qword TBC_OP_POOL = 0;
+    /** 内联立即数 */
+    static const qword TBC_OP_INLINE_IMM = 1;
+    /** 调用参数段 */
+    static const qword TBC_OP_ARG_SPAN = 2;
+    /** 空操作数 */
+    static const qword TBC_OP_EMPTY = 3;
+
+    /**
+     * @brief 格式错误
+     * 
+     */
+    [[noreturn]] static void Malformed() {
+        //TODO: throw an exception instead of const char *
+        throw "Malformed tbc module!";
+    }
+
+    /**
+     * @brief 写字符串
+     * 
+     * @param out 输出Buffer
+     * @param str 字符串
+     */
+    static void WriteString(ByteBuffer &out, std::string_view str) {
+        out.WriteVarU(str.size());
+        out.WriteBytes(str.data(), str.size());
+    }
+
+    /**
+     * @brief 读数量
+     * 
+     * 每项至少占1字节, 数量超过剩余字节数即为格式错误
+     * 
+     * @param in 输入Buffer
+     * @return 数量
+     */
+    static int ReadCount(ByteBuffer &in) {
+        const qword count = in.ReadVarU();
+        if (count > (qword)(in.GetWritePos() - in.GetReadPos())) {
+            Malformed();
+        }
+        return (int)count;
+    }
+
+    /**
+     * @brief 读字符串
+     * 
+     * @param in 输入Buffer
+     * @return 字符串(指向Buffer内部)
+     */
+    static std::string_view ReadString(ByteBuffer &in) {
+        const int length = ReadCount(in);
+        return std::string_view((const char *)in.Consume(length), length);
+    }
+
+    /**
+     * @brief 编码指令操作数
+     * 
+     * @param op 操作数
+     * @return 编码
+     */
+    static qword EncodeInsOperand(int op) {
+        if (op == -1) {
+            return TBC_OP_EMPTY;
+        }
+        if (IsInlineImm(op)) {
+            return (ZigZagEncode(GetInlineImm(op)) << 2) | TBC_OP_INLINE_IMM;
+        }
+        if (IsArgSpan(op)) {
+            return ((qword)((unsigned int)op & 0x7FFFFFFF) << 2) | TBC_OP_ARG_SPAN;
+        }
+        return ((qword)op << 2) | TBC_OP_POOL;
+    }
+
+    /**
+     * @brief 解码指令操作数
+     * 
+     * @param code 编码
+     * @param operandNum 操作数池大小
+     * @return 操作数
+     */
+    static int DecodeInsOperand(qword code, int operandNum) {
+        const qword payload = code >> 2;
+        switch (code & 3) {
+        case TBC_OP_POOL:
+            if (payload >= (qword)operandNum) {
+                Malformed();
+            }
+            return (int)payload;
+        case TBC_OP_INLINE_IMM: {
+            const long long value = ZigZagDecode(payload);
+            if (! FitsInlineImm(value)) {
+                Malformed();
+            }
+            return MakeInlineImm((int)value);
+        }
+        case TBC_OP_ARG_SPAN:
+            if (payload >= 0x7FFFFFFF) {
+                Malformed();
+            }
+            return (int)(0x80000000u | (dword)payload);
+        default:
+            if (payload != 0) {
+                Malformed();
+            }
+            return -1;
+        }
+    }
+
+    /**
+     * @brief 获取立即数字节数
+     * 
+     * @param type 立即数类型
+     * @return 字节数
+     */
+    static int ImmediateSize(imm::itype type) {
+        switch (type) {
+        case imm::itype::I8:
+        case imm::itype::UI8:
+        case imm::itype::BOOL:
+            return 1;
+        case imm::itype::I16:
+        case imm::itype::UI16:
+        case imm::itype::P16:
+            return 2;
+        case imm::itype::I32:
+        case imm::itype::UI32:
+        case imm::itype::P32:
+        case imm::itype::FLOAT:
+            return 4;
+        default:
+            return 8;
+        }
+    }
+
+    /**
+     * @brief 将操作数加入操作数表
+     * 
+     * 参数列表的参数先于参数列表加入, 加载时只需引用表中前面的项
+     * 
+     * @param pool 操作数池
+     * @param op 操作数
+     * @param ids 操作数表(表内下标 -> 操作数ID)
+     * @param slots 操作数ID -> 表内下标(不在表中为-1)
+     */
+    static void CollectOperand(OperandPool &pool, int op, std::vector<int> &ids, std::vector<int> &slots) {
+        if (op < 0 || IsInlineImm(op) || slots[op] != -1) {
+            return;
+        }
+        if (pool.GetOperandType(op) == OperandType::ARGLIST) {
+            for (int i = 0 ; i < pool.GetArgNum(op) ; i ++) {
+                if (pool.GetArg(op, i) == op) {
+                    //TODO: throw an exception instead of const char *
+                    throw "Cyclic argument list!";
+                }
+                CollectOperand(pool, pool.GetArg(op, i), ids, slots);
+            }
+        }
+        slots[op] = ids.size();
+        ids.push_back(op);
+    }
+
+    /**
+     * @brief 编码表内操作数
+     * 
+     * @param op 操作数
+     * @param slots 操作数ID -> 表内下标
+     * @return 编码
+     */
+    static qword EncodeLocalOperand(int op, const std::vector<int> &slots) {
+        if (op >= 0 && ! IsInlineImm(op)) {
+            return EncodeInsOperand(slots[op]);
+        }
+        return EncodeInsOperand(op);
+    }
+
+    /**
+     * @brief 解码表内操作数
+     * 
+     * @param code 编码
+     * @param ids 操作数表(已加载部分)
+     * @return 操作数
+     */
+    static int DecodeLocalOperand(qword code, const std::vector<int> &ids) {
+        const int op = DecodeInsOperand(code, ids.size());
+        if (op >= 0 && ! IsInlineImm(op)) {
+            return ids[op];
+        }
+        return op;
+    }
+
+    /**
+     * @brief 写操作数
+     * 
+     * @param out 输出Buffer
+     * @param pool 操作数池
+     * @param id 操作数ID
+     * @param slots 操作数ID -> 表内下标
+     */
+    static void WriteOperand(ByteBuffer &out, OperandPool &pool, int id, const std::vector<int> &slots) {
+        const OperandType type = pool.GetOperandType(id);
+        const bool arena = pool.GetMode() == OperandPoolMode::ARENA;
+        out.WriteByte((byte)type);
+        switch (type) {
+        case OperandType::IMMEDIATE: {
+            const imm::itype immType = arena ? (imm::itype)pool.GetRecord(id)->subType
+                : static_cast<ImmediateOperand *>(pool.GetOperand(id))->GetType();
+            const ImmediateValue value = arena ? pool.GetRecord(id)->value
+                : static_cast<ImmediateOperand *>(pool.GetOperand(id))->GetValue();
+            out.WriteByte((byte)immType);
+            switch (ImmediateSize(immType)) {
+            case 1:
+                out.WriteByte(value.ui8Val);
+                break;
+            case 2:
+                out.WriteWord(value.ui16Val);
+                break;
+            case 4:
+                out.WriteDword(value.ui32Val);
+                break;
+            default:
+                out.WriteQword(value.ui64Val);
+                break;
+            }
+            break;
+        }
+        case OperandType::SYMBOL: {
+            const SymbolScope scope = arena ? (SymbolScope)pool.GetRecord(id)->subType
+                : static_cast<SymbolOperand *>(pool.GetOperand(id))->GetScope();
+            out.WriteByte((byte)scope);
+            WriteString(out, pool.GetName(id).View());
+            break;
+        }
+        case OperandType::LABEL:
+            WriteString(out, pool.GetName(id).View());
+            break;
+        case OperandType::ARGLIST:
+            out.WriteVarU(pool.GetArgNum(id));
+            for (int i = 0 ; i < pool.GetArgNum(id) ; i ++) {
+                out.WriteVarU(EncodeLocalOperand(pool.GetArg(id, i), slots));
+            }
+            break;
+        case OperandType::EMPTY:
+        default:
+            break;
+        }
+    }
+
+    /**
+     * @brief 读操作数并加入操作数池
+     *
+     * 尽量通过GetOrAdd*加入, 使加载后的模块可以继续复用已有操作数
+     *
+     * @param in 输入Buffer
+     * @param pool 操作数池
+     * @param ids 操作数表(已加载部分)
+     * @return 操作数ID
+     */
+    static int LoadOperand(ByteBuffer &in, OperandPool &pool, const std::vector<int> &ids) {
+        switch ((OperandType)in.ReadByte()) {
+        case OperandType::EMPTY:
+            return pool.AppendEmpty();
+        case OperandType::IMMEDIATE: {
+            const byte immType = in.ReadByte();
+            if (immType > (byte)imm::itype::BOOL) {
+                Malformed();
+            }
+            ImmediateValue value;
+            value.ui64Val = 0;
+            switch (ImmediateSize((imm::itype)immType)) {
+            case 1:
+                value.ui8Val = in.ReadByte();
+                break;
+            case 2:
+                value.ui16Val = in.ReadWord();
+                break;
+            case 4:
+                value.ui32Val = in.ReadDword();
+                break;
+            default:
+                value.ui64Val = in.ReadQword();
+                break;
+            }
+            return pool.GetOrAddImmediate((imm::itype)immType, value);
+        }
+        case OperandType::SYMBOL: {
+            const byte scope = in.ReadByte();
+            if (scope > (byte)SymbolScope::BUILTIN) {
+                Malformed();
+            }
+            return pool.GetOrAddSymbol((SymbolScope)scope, ReadString(in));
+        }
+        case OperandType::LABEL:
+            return pool.GetOrAddLabel(ReadString(in));
+        case OperandType::ARGLIST: {
+            // 参数列表按函数复制, 不与其他函数共用
+            std::vector<int> args(ReadCount(in));
+            for (int &arg : args) {
+                arg = DecodeLocalOperand(in.ReadVarU(), ids);
+                if (IsArgSpan(arg)) {
+                    Malformed();
+                }
+            }
+            return pool.AppendArgList(args);
+        }
+        default:
+            Malformed();
+        }
+    }
+
+    /**
+     * @brief 写操作数表
+     *
+     * @param out 输出Buffer
+     * @param pool 操作数池
+     * @param ids 操作数表
+     * @param slots 操作数ID -> 表内下标
+     */
+    static void WriteOperandTable(ByteBuffer &out, OperandPool &pool, const std::vector<int> &ids, const std::vector<int> &slots) {
+        out.WriteVarU(ids.size());
+        for (int id : ids) {
+            WriteOperand(out, pool, id, slots);
+        }
+    }
+
+    /**
+     * @brief 读操作数表并加入操作数池
+     *
+     * @param in 输入Buffer
+     * @param pool 操作数池
+     * @param ids 操作数表(表内下标 -> 操作数ID)
+     */
+    static void LoadOperandTable(ByteBuffer &in, OperandPool &pool, std::vector<int> &ids) {
+        const int operandNum = ReadCount(in);
+        ids.clear();
+        ids.reserve(operandNum);
+        for (int i = 0 ; i < operandNum ; i ++) {
+            ids.push_back(LoadOperand(in, pool, ids));
+        }
+    }
+
+    /**
+     * @brief 写函数声明
+     * 
+     * @param out 输出Buffer
+     * @param decl 函数声明
+     */
+    static void WriteDecl(ByteBuffer &out, const IRFuncDecl &decl) {
+        WriteString(out, decl.name.View());
+        out.WriteVarS(decl.returnTypeId);
+        out.WriteVarS(decl.conventionId);
+        out.WriteVarU(decl.args.size());
+        for (const Argument &arg : decl.args) {
+            out.WriteVarS(arg.GetTypeId());
+            WriteString(out, arg.GetName().View());
+        }
+    }
+
+    /**
+     * @brief 读类型ID
+     * 
+     * @param in 输入Buffer
+     * @param man 类型管理器(类型已加载)
+     * @param allowNone 是否允许-1(无类型)
+     * @return 类型ID
+     */
+    static int ReadTypeId(ByteBuffer &in, TypeManager &man, bool allowNone) {
+        const long long typeId = in.ReadVarS();
+        if (typeId < (allowNone ? -1 : 0) || typeId >= man.GetTypeNum()) {
+            Malformed();
+        }
+        return (int)typeId;
+    }
+
+    /**
+     * @brief 读函数声明
+     * 
+     * @param in 输入Buffer
+     * @param man 类型管理器(类型已加载)
+     * @param decl 函数声明
+     */
+    static void LoadDecl(ByteBuffer &in, TypeManager &man, IRFuncDecl &decl) {
+        decl.name = ReadString(in);
+        decl.returnTypeId = ReadTypeId(in, man, true);
+        decl.conventionId = in.ReadVarS();
+        const int argNum = ReadCount(in);
+        decl.args.reserve(argNum);
+        for (int i = 0 ; i < argNum ; i ++) {
+            const int typeId = ReadTypeId(in, man, false);
+            decl.args.push_back(Argument(typeId, ReadString(in)));
+        }
+    }
+
+    /**
+     * @brief 跳过函数声明
+     * 
+     * 检查声明但不驻留其中的名称
+     * 
+     * @param in 输入Buffer
+     * @param man 类型管理器(类型已加载)
+     * @return 函数名(指向Buffer内部)
+     */
+    static std::string_view SkipDecl(ByteBuffer &in, TypeManager &man) {
+        const std::string_view name = ReadString(in);
+        ReadTypeId(in, man, true);
+        in.ReadVarS();
+        const int argNum = ReadCount(in);
+        for (int i = 0 ; i < argNum ; i ++) {
+            ReadTypeId(in, man, false);
+            ReadString(in);
+        }
+        return name;
+    }
+
+    /**
+     * @brief 写类型表
+     * 
+     * 只写内建类型以外的类型
+     * 
+     * @param out 输出Buffer
+     * @param man 类型管理器
+     */
+    static void WriteTypes(ByteBuffer &out, TypeManager &man) {
+        const int firstTypeId = man.GetBoolId() + 1;
+        out.WriteVarU(man.GetTypeNum() - firstTypeId);
+        for (int i = firstTypeId ; i < man.GetTypeNum() ; i ++) {
+            const Type *type = man.GetType(i);
+            const ComplexType *complexType = dynamic_cast<const ComplexType *>(type);
+            out.WriteByte(complexType != NULL ? TBC_TYPE_COMPLEX : TBC_TYPE_PLAIN);
+            WriteString(out, type->GetName());
+            if (complexType == NULL) {
+                out.WriteVarU(type->GetSize());
+                continue;
+            }
+            out.WriteVarU(complexType->GetAlign());
+            out.WriteVarU(complexType->GetTypeNum());
+            for (int j = 0 ; j < complexType->GetTypeNum() ; j ++) {
+                out.WriteVarU(complexType->GetMemberTypeId(j));
+            }
+        }
+        // 结构相同的复合类型共用一个类型, 其余名称作为别名保存
+        const std::vector<std::pair<std::string, int>> aliases = man.GetAliases();
+        out.WriteVarU(aliases.size());
+        for (const auto &alias : aliases) {
+            WriteString(out, alias.first);
+            out.WriteVarU(alias.second);
+        }
+    }
+
+    /**
+     * @brief 读类型表
+     * 
+     * @param in 输入Buffer
+     * @param man 类型管理器
+     */
+    static void LoadTypes(ByteBuffer &in, TypeManager &man) {
+        const int typeNum = ReadCount(in);
+        for (int i = 0 ; i < typeNum ; i ++) {
+            const int expected = man.GetTypeNum();
+            const byte kind = in.ReadByte();
+            const std::string name(ReadString(in));
+            int typeId;
+            if (kind == TBC_TYPE_PLAIN) {
+                typeId = man.AppendType(new Type((int)in.ReadVarU(), name));
+            }
+            else if (kind == TBC_TYPE_COMPLEX) {
+                const int align = in.ReadVarU();
+                const int memberNum = ReadCount(in);
+                ComplexTypeBuilder builder;
+                for (int j = 0 ; j < memberNum ; j ++) {
+                    const qword member = in.ReadVarU();
+                    if (member >= (qword)expected) {
+                        Malformed();
+                    }
+                    builder.AppendType(member);
+                }
+                typeId = man.AppendType(builder.Build(name, align, man));
+            }
+            else {
+                Malformed();
+            }
+            if (typeId != expected) {
+                Malformed();
+            }
+        }
+        const int aliasNum = ReadCount(in);
+        for (int i = 0 ; i < aliasNum ; i ++) {
+            const std::string name(ReadString(in));
+            const qword typeId = in.ReadVarU();
+            if (typeId >= (qword)man.GetTypeNum() || ! man.AppendAlias(name, (int)typeId)) {
+                Malformed();
+            }
+        }
+    }
+
+    /**
+     * @brief 写函数体
+     * 
+     * 函数体带有自己用到的操作数, 加载时不需要模块的其他部分
+     * 
+     * @param out 输出Buffer
+     * @param func 函数
+     * @param pool 操作数池
+     * @param slots 操作数ID -> 表内下标(全为-1, 写完后复原)
+     * @param used 被函数引用的操作数
+     */
+    static void WriteFunction(ByteBuffer &out, const IRFunction *func, OperandPool &pool, std::vector<int> &slots, std::vector<bool> &used) {
+        std::vector<int> ids;
+        const Span<const int> callArgs = func->GetCallArgs();
+        for (int arg : callArgs) {
+            CollectOperand(pool, arg, ids, slots);
+        }
+        for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+            for (const Ins &ins : func->GetBlock(i)->Instructions()) {
+                CollectOperand(pool, ins.GetDestOp(), ids, slots);
+                CollectOperand(pool, ins.GetSrc1Op(), ids, slots);
+                CollectOperand(pool, ins.GetSrc2Op(), ids, slots);
+            }
+        }
+
+        WriteDecl(out, func->GetDecl());
+        WriteOperandTable(out, pool, ids, slots);
+        out.WriteVarU(callArgs.GetSize());
+        for (int arg : callArgs) {
+            out.WriteVarU(EncodeLocalOperand(arg, slots));
+        }
+        out.WriteVarU(func->GetBlockNum());
+        for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+            const IRBasicBlock *block = func->GetBlock(i);
+            WriteString(out, block->GetName().View());
+            out.WriteVarU(block->GetArgNum());
+            for (int j = 0 ; j < block->GetArgNum() ; j ++) {
+                out.WriteVarS(block->GetArg(j).GetTypeId());
+                WriteString(out, block->GetArg(j).GetName().View());
+            }
+            out.WriteVarU(block->GetInsNum());
+            for (const Ins &ins : block->Instructions()) {
+                out.WriteByte((byte)ins.GetInsType());
+                out.WriteVarU(EncodeLocalOperand(ins.GetDestOp(), slots));
+                out.WriteVarU(EncodeLocalOperand(ins.GetSrc1Op(), slots));
+                out.WriteVarU(EncodeLocalOperand(ins.GetSrc2Op(), slots));
+            }
+        }
+        for (int id : ids) {
+            slots[id] = -1;
+            used[id] = true;
+        }
+    }
+
+    /**
+     * @brief 读函数体
+     * 
+     * 函数的操作数表在此时才加入操作数池
+     * 调用参数段按指令顺序重新追加到新函数的调用参数流中
+     * 
+     * @param in 输入Buffer
+     * @param pool 操作数池
+     * @param man 类型管理器(已加载)
+     * @return 函数
+     */
+    static IRFunction *LoadFunction(ByteBuffer &in, OperandPool &pool, TypeManager &man) {
+        IRFunctionBuilder fnBuilder;
+        LoadDecl(in, man, fnBuilder.GetDecl());
+        std::vector<int> ids;
+        LoadOperandTable(in, pool, ids);
+
+        std::vector<int> callArgs(ReadCount(in));
+        for (int &arg : callArgs) {
+            arg = DecodeLocalOperand(in.ReadVarU(), ids);
+            if (IsArgSpan(arg)) {
+                Malformed();
+            }
+        }
+
+        const int blockNum = ReadCount(in);
+        fnBuilder.Reserve(blockNum);
+        for (int i = 0 ; i < blockNum ; i ++) {
+            IRBasicBlockBuilder blockBuilder;
+            const Name name = ReadString(in);
+            const int argNum = ReadCount(in);
+            for (int j = 0 ; j < argNum ; j ++) {
+                const int typeId = ReadTypeId(in, man, false);
+                blockBuilder.AppendArg(Argument(typeId, ReadString(in)));
+            }
+            const int insNum = ReadCount(in);
+            blockBuilder.Reserve(insNum);
+            for (int j = 0 ; j < insNum ; j ++) {
+                const byte insType = in.ReadByte();
+                const int dest = DecodeLocalOperand(in.ReadVarU(), ids);
+                const int src1 = DecodeLocalOperand(in.ReadVarU(), ids);
+                int src2 = DecodeLocalOperand(in.ReadVarU(), ids);
+                if (insType > (byte)InsType::INV || IsArgSpan(dest) || IsArgSpan(src1)) {
+                    Malformed();
+                }
+                if (IsArgSpan(src2)) {
+                    const int offset = GetArgSpanOffset(src2);
+                    const int count = GetArgSpanCount(src2);
+                    if (offset + count > (int)callArgs.size()) {
+                        Malformed();
+                    }
+                    src2 = fnBuilder.AppendCallArgs(std::vector<int>(callArgs.begin() + offset, callArgs.begin() + offset + count));
+                }
+                blockBuilder.AppendIns(Ins((InsType)insType, dest, src1, src2));
+            }
+            fnBuilder.AppendBlock(blockBuilder.Build(name));
+        }
+
+        IRFunction *func = NULL;
+        if (fnBuilder.TryBuild(pool, func) != IRStatus::OK) {
+            Malformed();
+        }
+        return func;
+    }
+
+    /**
+     * @brief 将模块写为.tbc
+     * 
+     * @param module 模块
+     * @param out 输出Buffer
+     */
+    void WriteModule(IRModule &module, ByteBuffer &out) {
+        out.WriteDword(TBC_MAGIC);
+        out.WriteDword(TBC_VERSION);
+        WriteString(out, module.GetName().View());
+
+        WriteTypes(out, module.GetTypeManager());
+
+        // 先写出函数体以得到索引中的偏移与函数用到的操作数
+        OperandPool &pool = module.GetOperandPool();
+        std::vector<int> slots(pool.GetOperandNum(), -1);
+        std::vector<bool> used(pool.GetOperandNum(), false);
+        ByteBuffer bodies(4096);
+        std::vector<int> offsets;
+        offsets.reserve(module.GetFunctionNum() + 1);
+        for (int i = 0 ; i < module.GetFunctionNum() ; i ++) {
+            offsets.push_back(bodies.GetWritePos());
+            WriteFunction(bodies, module.GetFunction(i), pool, slots, used);
+        }
+        offsets.push_back(bodies.GetWritePos());
+
+        // 不被任何函数引用的操作数随模块保存
+        std::vector<int> ids;
+        for (int i = 0 ; i < pool.GetOperandNum() ; i ++) {
+            if (! used[i]) {
+                CollectOperand(pool, i, ids, slots);
+            }
+        }
+        WriteOperandTable(out, pool, ids, slots);
+
+        // 函数自带声明, 这里只写外部函数的声明
+        // 声明表的遍历顺序取决于名称驻留的历史, 按名称排序使输出确定
+        std::vector<const IRFuncDecl *> externDecls;
+        module.GetFuncDeclTab().ForEachFuncDecl([&](const IRFuncDecl &decl) {
+            if (module.GetFunction(decl.name) == NULL) {
+                externDecls.push_back(&decl);
+            }
+        });
+        std::sort(externDecls.begin(), externDecls.end(), [](const IRFuncDecl *a, const IRFuncDecl *b) {
+            return a->name.View() < b->name.View();
+        });
+        out.WriteVarU(externDecls.size());
+        for (const IRFuncDecl *decl : externDecls) {
+            WriteDecl(out, *decl);
+        }
+
+        out.WriteVarU(module.GetFunctionNum());
+        for (int i = 0 ; i < module.GetFunctionNum() ; i ++) {
+            WriteString(out, module.GetFunction(i)->GetDecl().name.View());
+            out.WriteVarU(offsets[i]);
+            out.WriteVarU(offsets[i + 1] - offsets[i]);
+        }
+        out.WriteBytes(bodies.GetData(), bodies.GetWritePos());
+    }
+
+    /**
+     * @brief 加载模块头部
+     * 
+     * 读取函数体之前的所有内容, 读指针停在第一个函数体开头
+     * 函数用到的操作数在函数体中, 此处不加载
+     * 
+     * @param in 输入Buffer
+     * @param entries 函数索引
+     * @param externs 外部函数声明索引(为NULL时直接加载声明)
+     * @return 模块(不含函数)
+     */
+    static IRModule *LoadModuleHead(ByteBuffer &in, std::vector<TbcFunctionEntry> &entries, std::vector<TbcFunctionEntry> *externs) {
+        if (in.ReadDword() != TBC_MAGIC) {
+            //TODO: throw an exception instead of const char *
+            throw "Not a tbc module!";
+        }
+        if (in.ReadDword() != TBC_VERSION) {
+            //TODO: throw an exception instead of const char *
+            throw "Unsupported tbc version!";
+        }
+        IRModule *module = new IRModule(ReadString(in));
+        try {
+            LoadTypes(in, module->GetTypeManager());
+
+            std::vector<int> ids;
+            LoadOperandTable(in, module->GetOperandPool(), ids);
+
+            const int declNum = ReadCount(in);
+            if (externs != NULL) {
+                externs->resize(declNum);
+            }
+            for (int i = 0 ; i < declNum ; i ++) {
+                if (externs != NULL) {
+                    TbcFunctionEntry &entry = (*externs)[i];
+                    entry.offset = in.GetReadPos();
+                    entry.name = SkipDecl(in, module->GetTypeManager());
+                    entry.size = in.GetReadPos() - entry.offset;
+                    continue;
+                }
+                IRFuncDecl decl;
+                LoadDecl(in, module->GetTypeManager(), decl);
+                module->GetFuncDeclTab().AppendFuncDecl(std::move(decl));
+            }
+
+            const int funcNum = ReadCount(in);
+            entries.resize(funcNum);
+            for (TbcFunctionEntry &entry : entries) {
+                entry.name = ReadString(in);
+                entry.offset = ReadCount(in);
+                entry.size = ReadCount(in);
+            }
+            const qword bodyBytes = in.GetWritePos() - in.GetReadPos();
+            for (const TbcFunctionEntry &entry : entries) {
+                if ((qword)entry.offset + entry.size > bodyBytes) {
+                    Malformed();
+                }
+            }
+        }
+        catch (...) {
+            delete module;
+            throw;
+        }
+        return module;
+    }
+
+    /**
+     * @brief 从.tbc加载模块
+     * 
+     * @param in 输入Buffer(从读指针处开始)
+     * @return 模块
+     */
+    IRModule *LoadModule(ByteBuffer &in) {
+        std::vector<TbcFunctionEntry> entries;
+        IRModule *module = LoadModuleHead(in, entries, NULL);
+        try {
+            const int bodyBase = in.GetReadPos();
+            for (const TbcFunctionEntry &entry : entries) {
+                if (entry.offset != in.GetReadPos() - bodyBase) {
+                    Malformed();
+                }
+                IRFunction *func = LoadFunction(in, module->GetOperandPool(), module->GetTypeManager());
+                if (module->AppendFunction(func) == -1) {
+                    delete func;
+                    Malformed();
+                }
+            }
+        }
+        catch (...) {
+            delete module;
+            throw;
+        }
+        return module;
+    }
+
+    /**
+     * @brief 将模块写为.tbc文件
+     * 
+     * @param module 模块
+     * @param path 文件路径
+     */
+    void WriteModuleFile(IRModule &module, const char *path) {
+        ByteBuffer buffer(64 * 1024);
+        WriteModule(module, buffer);
+        FILE *file = fopen(path, "wb");
+        if (file == NULL) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't open file!";
+        }
+        const size_t written = fwrite(buffer.GetData(), 1, buffer.GetWritePos(), file);
+        fclose(file);
+        if (written != (size_t)buffer.GetWritePos()) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't write file!";
+        }
+    }
+
+    /**
+     * @brief 从.tbc文件加载模块
+     * 
+     * @param path 文件路径
+     * @return 模块
+     */
+    IRModule *LoadModuleFile(const char *path) {
+        FILE *file = fopen(path, "rb");
+        if (file == NULL) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't open file!";
+        }
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size < 0 || size > 0x7FFFFFFF) {
+            fclose(file);
+            //TODO: throw an exception instead of const char *
+            throw "Can't read file!";
+        }
+        ByteBuffer buffer(size);
+        const size_t read = fread(buffer.Claim(size), 1, size, file);
+        fclose(file);
+        if (read != (size_t)size) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't read file!";
+        }
+        return LoadModule(buffer);
+    }
+
+//--------------------------------------
+
+    /**
+     * @brief IRLazyModule构造函数
+     * 
+     * @param path 文件路径
+     */
+    IRLazyModule::IRLazyModule(const char *path)
+        : image(NULL), imageSize(0), bodyBase(0), module(NULL)
+    {
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't open file!";
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0 || info.st_size > 0x7FFFFFFF) {
+            close(fd);
+            //TODO: throw an exception instead of const char *
+            throw "Can't read file!";
+        }
+        imageSize = info.st_size;
+        void *mapped = mmap(NULL, imageSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't map file!";
+        }
+        image = (const byte *)mapped;
+        // 函数体按需访问, 关闭预读
+        madvise(mapped, imageSize, MADV_RANDOM);
+
+        try {
+            ByteBuffer in(image, imageSize);
+            module = LoadModuleHead(in, entries, &externs);
+            bodyBase = in.GetReadPos();
+        }
+        catch (...) {
+            munmap((void *)image, imageSize);
+            throw;
+        }
+        loaded.resize(entries.size(), NULL);
+        entryIndex.reserve(entries.size());
+        for (int i = 0 ; i < (int)entries.size() ; i ++) {
+            entryIndex.insert(std::make_pair(entries[i].name, i));
+        }
+        externLoaded.resize(externs.size(), false);
+        externIndex.reserve(externs.size());
+        for (int i = 0 ; i < (int)externs.size() ; i ++) {
+            externIndex.insert(std::make_pair(externs[i].name, i));
+        }
+    }
+
+    /**
+     * @brief IRLazyModule析构函数
+     * 
+     */
+    IRLazyModule::~IRLazyModule() {
+        delete module;
+        module = NULL;
+        if (image != NULL) {
+            munmap((void *)image, imageSize);
+            image = NULL;
+        }
+    }
+
+    /**
+     * @brief 获取函数数量
+     * 
+     * @return 函数数量(包括未加载的)
+     */
+    const int IRLazyModule::GetFunctionNum() const {
+        return entries.size();
+    }
+
+    /**
+     * @brief 获取已加载的函数数量
+     * 
+     * @return 已加载的函数数量
+     */
+    const int IRLazyModule::GetLoadedFunctionNum() const {
+        return module->GetFunctionNum();
+    }
+
+    /**
+     * @brief 获取函数名
+     * 
+     * 不加载函数
+     * 
+     * @param sub 索引下标
+     * @return 函数名
+     */
+    std::string_view IRLazyModule::GetFunctionName(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)entries.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return entries[sub].name;
+    }
+
+    /**
+     * @brief 获取函数
+     * 
+     * 未加载时加载
+     * 
+     * @param sub 索引下标
+     * @return 函数
+     */
+    const IRFunction *IRLazyModule::GetFunction(int sub) {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)entries.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        if (loaded[sub] != NULL) {
+            return loaded[sub];
+        }
+        const TbcFunctionEntry &entry = entries[sub];
+        ByteBuffer in(image + bodyBase + entry.offset, entry.size);
+        IRFunction *func = LoadFunction(in, module->GetOperandPool(), module->GetTypeManager());
+        if (func->GetDecl().name.View() != entry.name || module->AppendFunction(func) == -1) {
+            delete func;
+            Malformed();
+        }
+        loaded[sub] = func;
+        return func;
+    }
+
+    /**
+     * @brief 获取函数
+     * 
+     * 未加载时加载
+     * 
+     * @param name 函数名
+     * @return 函数(不存在时为NULL)
+     */
+    const IRFunction *IRLazyModule::GetFunction(Name name) {
+        auto iter = entryIndex.find(name.View());
+        if (iter == entryIndex.end()) {
+            return NULL;
+        }
+        return GetFunction(iter->second);
+    }
+
+    /**
+     * @brief 获取外部函数声明数量
+     * 
+     * @return 外部函数声明数量(包括未加载的)
+     */
+    const int IRLazyModule::GetExternDeclNum() const {
+        return externs.size();
+    }
+
+    /**
+     * @brief 获取外部函数声明
+     * 
+     * 未加载时从映像中解码并加入模块的声明表
+     * 
+     * @param name 函数名
+     * @return 函数声明(不存在时为NULL)
+     */
+    const IRFuncDecl *IRLazyModule::GetExternDecl(Name name) {
+        auto iter = externIndex.find(name.View());
+        if (iter == externIndex.end()) {
+            return NULL;
+        }
+        const int sub = iter->second;
+        if (! externLoaded[sub]) {
+            ByteBuffer in(image + externs[sub].offset, externs[sub].size);
+            IRFuncDecl decl;
+            LoadDecl(in, module->GetTypeManager(), decl);
+            module->GetFuncDeclTab().AppendFuncDecl(std::move(decl));
+            externLoaded[sub] = true;
+        }
+        return &module->GetFuncDeclTab().GetFuncDecl(name);
+    }
+
+    /**
+     * @brief 获取模块
+     * 
+     * 模块中只有已加载的函数与外部函数声明
+     * 
+     * @return 模块
+     */
+    IRModule &IRLazyModule::GetModule() {
+        return *module;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+/**
+ * @file bytecode.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 二进制IR模块格式(.tbc)
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/module.h>
+#include <utils/buffer.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tayir {
+    /**
+     * .tbc格式(小端序, 整数除特别说明外均为LEB128变长整数, 有符号数为zigzag):
+     * 
+     * | 内容         | 编码                                              |
+     * |--------------|---------------------------------------------------|
+     * | 文件头       | 魔数"TBC\0"(4字节), 版本(dword)                   |
+     * | 模块名       | 字符串(长度 + 字节)                               |
+     * | 类型         | 数量, 每项: 种类(字节), 名称, 大小或对齐+成员类型 |
+     * | 类型别名     | 数量, 每项: 别名, 类型ID                          |
+     * | 模块操作数   | 操作数表(不被任何函数引用的操作数)                |
+     * | 外部函数声明 | 数量, 每项: 函数声明                              |
+     * | 函数索引     | 数量, 每项: 函数名, 函数体偏移, 函数体字节数      |
+     * | 函数体       | 函数声明, 操作数表, 调用参数流, 基本块            |
+     * 
+     * 操作数表: 数量, 每项: 操作数类型(字节), 内容
+     * 函数体偏移相对于第一个函数体开头, 每个函数体只引用自己的操作数表, 可据此只加载需要的函数
+     * 指令操作数以低2位区分: 0为所在操作数表的下标, 1为内联立即数, 2为调用参数段, 3为空
+     * 
+     */
+
+    /** .tbc魔数 */
+    static const dword TBC_MAGIC = 0x00434254;
+    /** .tbc版本 */
+    static const dword TBC_VERSION = 1;
+
+    /**
+     * @brief 函数索引项
+     * 
+     * 也用于按需加载的外部函数声明
+     * 
+     */
+    struct TbcFunctionEntry {
+        /** 函数名(指向模块映像) */
+        std::string_view name;
+        /** 函数体(或声明)偏移 */
+        int offset;
+        /** 函数体(或声明)字节数 */
+        int size;
+    };
+
+    /**
+     * @brief 将模块写为.tbc
+     * 
+     * @param module 模块
+     * @param out 输出Buffer
+     */
+    void WriteModule(IRModule &module, ByteBuffer &out);
+
+    /**
+     * @brief 从.tbc加载模块
+     * 
+     * @param in 输入Buffer(从读指针处开始)
+     * @return 模块
+     */
+    IRModule *LoadModule(ByteBuffer &in);
+
+    /**
+     * @brief 将模块写为.tbc文件
+     * 
+     * @param module 模块
+     * @param path 文件路径
+     */
+    void WriteModuleFile(IRModule &module, const char *path);
+
+    /**
+     * @brief 从.tbc文件加载模块
+     * 
+     * @param path 文件路径
+     * @return 模块
+     */
+    IRModule *LoadModuleFile(const char *path);
+
+    /**
+     * @brief 按需加载的.tbc模块
+     * 
+     * 将文件映射到内存, 打开时只加载类型, 模块操作数与函数索引
+     * 函数在第一次GetFunction时才从映像中解码, 其操作数同时加入操作数池
+     * 外部函数声明在第一次GetExternDecl时才解码并加入声明表
+     * 函数名与外部函数名直接引用映像, 不复制也不驻留
+     * 
+     */
+    class IRLazyModule {
+    protected:
+        /** 模块映像 */
+        const byte *image;
+        /** 映像字节数 */
+        size_t imageSize;
+        /** 第一个函数体在映像中的偏移 */
+        int bodyBase;
+        /** 模块(只含已加载的函数) */
+        IRModule *module;
+        /** 函数索引 */
+        std::vector<TbcFunctionEntry> entries;
+        /** 已加载的函数(未加载为NULL) */
+        std::vector<const IRFunction *> loaded;
+        /** 函数名 -> 索引下标 */
+        std::unordered_map<std::string_view, int> entryIndex;
+        /** 外部函数声明索引(偏移相对于映像开头) */
+        std::vector<TbcFunctionEntry> externs;
+        /** 外部函数声明是否已加载 */
+        std::vector<bool> externLoaded;
+        /** 外部函数名 -> 外部函数声明索引下标 */
+        std::unordered_map<std::string_view, int> externIndex;
+    public:
+        /**
+         * @brief IRLazyModule构造函数
+         * 
+         * @param path 文件路径
+         */
+        IRLazyModule(const char *path);
+        /**
+         * @brief IRLazyModule析构函数
+         * 
+         */
+        ~IRLazyModule();
+        IRLazyModule(const IRLazyModule &) = delete;
+        IRLazyModule &operator=(const IRLazyModule &) = delete;
+        /**
+         * @brief 获取函数数量
+         * 
+         * @return 函数数量(包括未加载的)
+         */
+        const int GetFunctionNum() const;
+        /**
+         * @brief 获取已加载的函数数量
+         * 
+         * @return 已加载的函数数量
+         */
+        const int GetLoadedFunctionNum() const;
+        /**
+         * @brief 获取函数名
+         * 
+         * 不加载函数
+         * 
+         * @param sub 索引下标
+         * @return 函数名
+         */
+        std::string_view GetFunctionName(int sub) const;
+        /**
+         * @brief 获取函数
+         * 
+         * 未加载时加载
+         * 
+         * @param sub 索引下标
+         * @return 函数
+         */
+        const IRFunction *GetFunction(int sub);
+        /**
+         * @brief 获取函数
+         * 
+         * 未加载时加载
+         * 
+         * @param name 函数名
+         * @return 函数(不存在时为NULL)
+         */
+        const IRFunction *GetFunction(Name name);
+        /**
+         * @brief 获取外部函数声明数量
+         * 
+         * @return 外部函数声明数量(包括未加载的)
+         */
+        const int GetExternDeclNum() const;
+        /**
+         * @brief 获取外部函数声明
+         * 
+         * 未加载时从映像中解码并加入模块的声明表
+         * 
+         * @param name 函数名
+         * @return 函数声明(不存在时为NULL)
+         */
+        const IRFuncDecl *GetExternDecl(Name name);
+        /**
+         * @brief 获取模块
+         * 
+         * 模块中只有已加载的函数与外部函数声明
+         * 
+         * @return 模块
+         */
+        IRModule &GetModule();
+    };
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/**
+ * @file columns.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 列式指令存储
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/columns.h>
+#include <utils/check.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tayir {
+    static_assert((int)InsType::INV < 256, "InsType must fit in a byte");
+
+    /**
+     * @brief IRColumnFragment构造函数
+     * 
+     * @param slice 源切片(片段, 基本块或函数)
+     */
+    IRColumnFragment::IRColumnFragment(const IRSlice &slice)
+        : insNum(slice.GetInsNum()), insTypes(insNum), destOps(insNum), src1Ops(insNum), src2Ops(insNum)
+    {
+        for (int i = 0 ; i < insNum ; i ++) {
+            const Ins ins = slice.GetIns(i);
+            insTypes[i] = (byte)ins.GetInsType();
+            destOps[i] = ins.GetDestOp();
+            src1Ops[i] = ins.GetSrc1Op();
+            src2Ops[i] = ins.GetSrc2Op();
+        }
+    }
+
+    /**
+     * @brief IRColumnFragment析构函数
+     * 
+     */
+    IRColumnFragment::~IRColumnFragment() {
+    }
+
+    /**
+     * @brief 获取指令数量
+     * 
+     * @return 指令数量
+     */
+    const int IRColumnFragment::GetInsNum() const {
+        return insNum;
+    }
+
+    /**
+     * @brief 获取指令
+     * 
+     * @param sub 下标
+     * @return 指令
+     */
+    const Ins IRColumnFragment::GetIns(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, insNum)) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return Ins((InsType)insTypes[sub], destOps[sub], src1Ops[sub], src2Ops[sub]);
+    }
+
+    /**
+     * @brief 查找指定类型的指令
+     * 
+     * @param type 指令类型
+     * @param subs 输出: 指令下标
+     * @return 找到的指令数
+     */
+    int IRColumnFragment::FindIns(InsType type, std::vector<int> &subs) const {
+        const byte *types = insTypes.data();
+        const size_t oldSize = subs.size();
+        int i = 0;
+#if defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi8((char)type);
+        for ( ; i + 32 <= insNum ; i += 32) {
+            __m256i chunk = _mm256_loadu_si256((const __m256i *)(types + i));
+            unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+            while (mask != 0) {
+                subs.push_back(i + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi8((char)type);
+        for ( ; i + 16 <= insNum ; i += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(types + i));
+            unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+            while (mask != 0) {
+                subs.push_back(i + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for ( ; i < insNum ; i ++) {
+            if (types[i] == (byte)type) {
+                subs.push_back(i);
+            }
+        }
+        return subs.size() - oldSize;
+    }
+
+    /**
+     * @brief 统计指定类型的指令数
+     * 
+     * @param type 指令类型
+     * @return 指令数
+     */
+    int IRColumnFragment::CountIns(InsType type) const {
+        const byte *types = insTypes.data();
+        int count = 0;
+        int i = 0;
+#if defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi8((char)type);
+        for ( ; i + 32 <= insNum ; i += 32) {
+            __m256i chunk = _mm256_loadu_si256((const __m256i *)(types + i));
+            count += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        }
+#elif defined(__SSE2__)
+        const __m128i needle = _mm_set1_epi8((char)type);
+        for ( ; i + 16 <= insNum ; i += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(types + i));
+            count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        }
+#endif
+        for ( ; i < insNum ; i ++) {
+            count += types[i] == (byte)type;
+        }
+        return count;
+    }
+
+    /**
+     * @brief 收集所有定义
+     * 
+     * 即所有带目的数的非br指令的目的数
+     * 
+     * @param defs 输出: 被定义的操作数ID
+     * @return 定义数
+     */
+    int IRColumnFragment::CollectDefs(std::vector<int> &defs) const {
+        const size_t oldSize = defs.size();
+        for (int i = 0 ; i < insNum ; i ++) {
+            // br的目的数位置存放的是条件
+            if (destOps[i] != -1 && insTypes[i] != (byte)InsType::BR) {
+                defs.push_back(destOps[i]);
+            }
+        }
+        return defs.size() - oldSize;
+    }
+}
\ No newline at end of file
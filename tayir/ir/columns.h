@@ -0,0 +1,126 @@
+/**
+ * @file columns.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 列式指令存储
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/slice.h>
+#include <utils/types.h>
+#include <utils/span.h>
+
+#include <vector>
+
+namespace tayir {
+    /**
+     * @brief 列式IR片段
+     * 
+     * @see IRFragment
+     * 
+     * 将指令类型, 目的数, 操作数1, 操作数2分别存放在独立数组中(SoA)
+     * 只扫描某一列的分析(如查找所有call, 收集所有定义)不必读取整条指令
+     * 指令类型列以字节存储, 便于SIMD批量比较
+     * 
+     */
+    class IRColumnFragment : public IRSlice {
+    protected:
+        /** 指令数 */
+        const int insNum;
+        /** 指令类型列 */
+        std::vector<byte> insTypes;
+        /** 目的数列 */
+        std::vector<int> destOps;
+        /** 操作数1列 */
+        std::vector<int> src1Ops;
+        /** 操作数2列 */
+        std::vector<int> src2Ops;
+    public:
+        /**
+         * @brief IRColumnFragment构造函数
+         * 
+         * @param slice 源切片(片段, 基本块或函数)
+         */
+        IRColumnFragment(const IRSlice &slice);
+        /**
+         * @brief IRColumnFragment析构函数
+         * 
+         */
+        virtual ~IRColumnFragment();
+        /**
+         * @brief 获取指令数量
+         * 
+         * @return 指令数量
+         */
+        virtual const int GetInsNum() const override;
+        /**
+         * @brief 获取指令
+         * 
+         * @param sub 下标
+         * @return 指令
+         */
+        virtual const Ins GetIns(int sub) const override;
+        /**
+         * @brief 获取指令类型列
+         * 
+         * @return 指令类型列
+         */
+        Span<const byte> GetInsTypes() const {
+            return Span<const byte>(insTypes.data(), insNum);
+        }
+        /**
+         * @brief 获取目的数列
+         * 
+         * @return 目的数列
+         */
+        Span<const int> GetDestOps() const {
+            return Span<const int>(destOps.data(), insNum);
+        }
+        /**
+         * @brief 获取操作数1列
+         * 
+         * @return 操作数1列
+         */
+        Span<const int> GetSrc1Ops() const {
+            return Span<const int>(src1Ops.data(), insNum);
+        }
+        /**
+         * @brief 获取操作数2列
+         * 
+         * @return 操作数2列
+         */
+        Span<const int> GetSrc2Ops() const {
+            return Span<const int>(src2Ops.data(), insNum);
+        }
+        /**
+         * @brief 查找指定类型的指令
+         * 
+         * @param type 指令类型
+         * @param subs 输出: 指令下标
+         * @return 找到的指令数
+         */
+        int FindIns(InsType type, std::vector<int> &subs) const;
+        /**
+         * @brief 统计指定类型的指令数
+         * 
+         * @param type 指令类型
+         * @return 指令数
+         */
+        int CountIns(InsType type) const;
+        /**
+         * @brief 收集所有定义
+         * 
+         * 即所有带目的数的非br指令的目的数
+         * 
+         * @param defs 输出: 被定义的操作数ID
+         * @return 定义数
+         */
+        int CollectDefs(std::vector<int> &defs) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/**
+ * @file defuse.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 定义-使用链
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/defuse.h>
+
+#include <algorithm>
+
+namespace tayir {
+    /**
+     * @brief 是否为需要追踪的值
+     * 
+     * @param op 操作数
+     * @return 是否为符号操作数
+     */
+    bool IRDefUse::IsValue(int op) const {
+        if (op < 0 || IsInlineImm(op)) {
+            return false;
+        }
+        return pool.GetOperandType(op) == OperandType::SYMBOL;
+    }
+
+    /**
+     * @brief 登记使用
+     * 
+     * @param op 操作数
+     * @param use 使用位置
+     */
+    void IRDefUse::AddUse(int op, const IRUse &use) {
+        useTab[op].push_back(use);
+    }
+
+    /**
+     * @brief 收集一条指令中的使用
+     * 
+     * @param ins 指令
+     * @param blockSub 基本块下标
+     * @param insSub 块内指令下标
+     */
+    void IRDefUse::CollectUses(const Ins &ins, int blockSub, int insSub) {
+        // br的目的数位置存放的是条件, 属于使用
+        if (ins.GetInsType() == InsType::BR && IsValue(ins.GetCondOp())) {
+            AddUse(ins.GetCondOp(), IRUse{blockSub, insSub, IRUse::SLOT_DEST});
+        }
+        if (IsValue(ins.GetSrc1Op())) {
+            AddUse(ins.GetSrc1Op(), IRUse{blockSub, insSub, IRUse::SLOT_SRC1});
+        }
+        const int src2 = ins.GetSrc2Op();
+        if (IsValue(src2)) {
+            AddUse(src2, IRUse{blockSub, insSub, IRUse::SLOT_SRC2});
+        }
+        else if (IsArgSpan(src2)) {
+            const Span<const int> args = func->GetCallArgs(src2);
+            for (size_t i = 0 ; i < args.GetSize() ; i ++) {
+                if (IsValue(args[i])) {
+                    AddUse(args[i], IRUse{blockSub, insSub, IRUse::SLOT_ARG + (int)i});
+                }
+            }
+        }
+        else if (src2 >= 0 && ! IsInlineImm(src2) && pool.GetOperandType(src2) == OperandType::ARGLIST) {
+            const int argNum = pool.GetArgNum(src2);
+            for (int i = 0 ; i < argNum ; i ++) {
+                if (IsValue(pool.GetArg(src2, i))) {
+                    AddUse(pool.GetArg(src2, i), IRUse{blockSub, insSub, IRUse::SLOT_ARG + i});
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 改写使用位置上的操作数
+     * 
+     * 操作数池中的参数列表先复制再改写, 不影响其他函数
+     * 
+     * @param use 使用位置
+     * @param op 新操作数
+     */
+    void IRDefUse::Rewrite(const IRUse &use, int op) {
+        Ins &ins = func->GetBlock(use.blockSub)->Instructions()[use.insSub];
+        switch (use.slot) {
+        case IRUse::SLOT_DEST:
+            ins.SetDestOp(op);
+            break;
+        case IRUse::SLOT_SRC1:
+            ins.SetSrc1Op(op);
+            break;
+        case IRUse::SLOT_SRC2:
+            ins.SetSrc2Op(op);
+            break;
+        default:
+            if (IsArgSpan(ins.GetSrc2Op())) {
+                func->GetCallArgs()[GetArgSpanOffset(ins.GetSrc2Op()) + use.slot - IRUse::SLOT_ARG] = op;
+            }
+            else {
+                if (ownedArgLists.count(ins.GetSrc2Op()) == 0) {
+                    const int shared = ins.GetSrc2Op();
+                    std::vector<int> args(pool.GetArgNum(shared));
+                    for (int i = 0 ; i < (int)args.size() ; i ++) {
+                        args[i] = pool.GetArg(shared, i);
+                    }
+                    ins.SetSrc2Op(pool.AppendArgList(args));
+                    ownedArgLists.insert(ins.GetSrc2Op());
+                }
+                pool.SetArg(ins.GetSrc2Op(), use.slot - IRUse::SLOT_ARG, op);
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief IRDefUse构造函数
+     * 
+     * 扫描函数一次, 建立所有使用列表
+     * 
+     * @param func 函数
+     * @param pool 操作数池
+     */
+    IRDefUse::IRDefUse(IRFunction *func, OperandPool &pool)
+        : func(func), pool(pool)
+    {
+        for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+            Span<const Ins> block = func->GetBlock(i)->Instructions();
+            for (int j = 0 ; j < (int)block.GetSize() ; j ++) {
+                CollectUses(block[j], i, j);
+            }
+        }
+    }
+
+    /**
+     * @brief 获取函数
+     * 
+     * @return 函数
+     */
+    const IRFunction *IRDefUse::GetFunction() const {
+        return func;
+    }
+
+    /**
+     * @brief 获取使用数量
+     * 
+     * @param op 操作数
+     * @return 使用数量
+     */
+    const int IRDefUse::GetUseNum(int op) const {
+        auto iter = useTab.find(op);
+        if (iter == useTab.end()) {
+            return 0;
+        }
+        return iter->second.size();
+    }
+
+    /**
+     * @brief 获取使用位置列表
+     * 
+     * @param op 操作数
+     * @return 使用位置列表
+     */
+    const std::vector<IRUse> &IRDefUse::GetUses(int op) const {
+        static const std::vector<IRUse> noUses;
+        auto iter = useTab.find(op);
+        if (iter == useTab.end()) {
+            return noUses;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取使用者
+     * 
+     * 同一条指令多次使用时只记录一次, 结果按指令顺序排列
+     * 
+     * @param op 操作数
+     * @param users 输出: 使用者(仅blockSub与insSub有效)
+     * @return 使用者数量
+     */
+    int IRDefUse::GetUsers(int op, std::vector<IRUse> &users) const {
+        const size_t oldSize = users.size();
+        const std::vector<IRUse> &uses = GetUses(op);
+        users.insert(users.end(), uses.begin(), uses.end());
+        auto less = [](const IRUse &a, const IRUse &b) {
+            return a.blockSub != b.blockSub ? a.blockSub < b.blockSub : a.insSub < b.insSub;
+        };
+        auto same = [](const IRUse &a, const IRUse &b) {
+            return a.blockSub == b.blockSub && a.insSub == b.insSub;
+        };
+        std::sort(users.begin() + oldSize, users.end(), less);
+        users.erase(std::unique(users.begin() + oldSize, users.end(), same), users.end());
+        return users.size() - oldSize;
+    }
+
+    /**
+     * @brief 替换所有使用
+     * 
+     * 将oldOp的所有使用改写为newOp, newOp可以是立即数等非符号操作数
+     * 
+     * @param oldOp 被替换的操作数
+     * @param newOp 新操作数
+     * @return 被改写的使用数
+     */
+    int IRDefUse::ReplaceAllUsesWith(int oldOp, int newOp) {
+        if (oldOp == newOp) {
+            return 0;
+        }
+        auto iter = useTab.find(oldOp);
+        if (iter == useTab.end()) {
+            return 0;
+        }
+        std::vector<IRUse> uses = std::move(iter->second);
+        const int useNum = uses.size();
+        useTab.erase(iter);
+        for (const IRUse &use : uses) {
+            Rewrite(use, newOp);
+        }
+        if (IsValue(newOp)) {
+            std::vector<IRUse> &newUses = useTab[newOp];
+            if (newUses.empty()) {
+                newUses = std::move(uses);
+            }
+            else {
+                newUses.insert(newUses.end(), uses.begin(), uses.end());
+            }
+        }
+        return useNum;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+ * @file defuse.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 定义-使用链
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/operand.h>
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tayir {
+    /**
+     * @brief 使用位置
+     * 
+     * @see IRDefUse
+     * 
+     */
+    struct IRUse {
+        /** 目的数(br的条件) */
+        static const int SLOT_DEST = 0;
+        /** 操作数1 */
+        static const int SLOT_SRC1 = 1;
+        /** 操作数2 */
+        static const int SLOT_SRC2 = 2;
+        /** 参数列表中的第0个参数, 第i个参数为SLOT_ARG + i */
+        static const int SLOT_ARG = 3;
+        /** 基本块下标 */
+        int blockSub;
+        /** 块内指令下标 */
+        int insSub;
+        /** 操作数位置 */
+        int slot;
+    };
+
+    /**
+     * @brief 定义-使用链
+     * 
+     * 为函数中的每个符号操作数维护其使用位置列表
+     * 改写操作数时直接修改函数中的指令(及参数列表), 代价与被改写的使用数成正比
+     * 
+     * 只有通过本类进行的改写会被同步到使用列表中
+     * 操作数池中的参数列表可能被其他函数共享, 第一次改写时为指令复制一份再改写
+     * 
+     */
+    class IRDefUse {
+    protected:
+        /** 函数 */
+        IRFunction *func;
+        /** 操作数池 */
+        OperandPool &pool;
+        /** 符号操作数ID -> 使用位置列表 */
+        std::unordered_map<int, std::vector<IRUse>> useTab;
+        /** 为改写复制出的参数列表(只被本函数的一条指令使用) */
+        std::unordered_set<int> ownedArgLists;
+        /**
+         * @brief 是否为需要追踪的值
+         * 
+         * @param op 操作数
+         * @return 是否为符号操作数
+         */
+        bool IsValue(int op) const;
+        /**
+         * @brief 登记使用
+         * 
+         * @param op 操作数
+         * @param use 使用位置
+         */
+        void AddUse(int op, const IRUse &use);
+        /**
+         * @brief 收集一条指令中的使用
+         * 
+         * @param ins 指令
+         * @param blockSub 基本块下标
+         * @param insSub 块内指令下标
+         */
+        void CollectUses(const Ins &ins, int blockSub, int insSub);
+        /**
+         * @brief 改写使用位置上的操作数
+         * 
+         * 操作数池中的参数列表先复制再改写, 不影响其他函数
+         * 
+         * @param use 使用位置
+         * @param op 新操作数
+         */
+        void Rewrite(const IRUse &use, int op);
+    public:
+        /**
+         * @brief IRDefUse构造函数
+         * 
+         * 扫描函数一次, 建立所有使用列表
+         * 
+         * @param func 函数
+         * @param pool 操作数池
+         */
+        IRDefUse(IRFunction *func, OperandPool &pool);
+        /**
+         * @brief 获取函数
+         * 
+         * @return 函数
+         */
+        const IRFunction *GetFunction() const;
+        /**
+         * @brief 获取使用数量
+         * 
+         * @param op 操作数
+         * @return 使用数量
+         */
+        const int GetUseNum(int op) const;
+        /**
+         * @brief 获取使用位置列表
+         * 
+         * @param op 操作数
+         * @return 使用位置列表
+         */
+        const std::vector<IRUse> &GetUses(int op) const;
+        /**
+         * @brief 获取使用者
+         * 
+         * 同一条指令多次使用时只记录一次, 结果按指令顺序排列
+         * 
+         * @param op 操作数
+         * @param users 输出: 使用者(仅blockSub与insSub有效)
+         * @return 使用者数量
+         */
+        int GetUsers(int op, std::vector<IRUse> &users) const;
+        /**
+         * @brief 替换所有使用
+         * 
+         * 将oldOp的所有使用改写为newOp, newOp可以是立即数等非符号操作数
+         * 
+         * @param oldOp 被替换的操作数
+         * @param newOp 新操作数
+         * @return 被改写的使用数
+         */
+        int ReplaceAllUsesWith(int oldOp, int newOp);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/**
+ * @file editable.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 可编辑基本块
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/editable.h>
+
+namespace tayir {
+    /**
+     * @brief 申请节点
+     * 
+     * @param ins 指令
+     * @return 节点
+     */
+    int IREditableBlock::NewNode(const Ins &ins) {
+        int node = freeList;
+        if (node != SENTINEL) {
+            freeList = nodes[node].next;
+            nodes[node].ins = ins;
+        }
+        else {
+            node = nodes.size();
+            nodes.push_back(Node{ins, SENTINEL, SENTINEL});
+        }
+        return node;
+    }
+
+    /**
+     * @brief 将节点链接到pos之前
+     * 
+     * @param node 节点
+     * @param pos 位置
+     */
+    void IREditableBlock::Link(int node, int pos) {
+        int prev = nodes[pos].prev;
+        nodes[node].prev = prev;
+        nodes[node].next = pos;
+        nodes[prev].next = node;
+        nodes[pos].prev = node;
+        insNum ++;
+    }
+
+    /**
+     * @brief IREditableBlock构造函数
+     * 
+     * 空基本块
+     * 
+     * @param name 基本块名
+     */
+    IREditableBlock::IREditableBlock(Name name)
+        : nodes(1, Node{Ins(), SENTINEL, SENTINEL}), freeList(SENTINEL), insNum(0), name(name)
+    {
+    }
+
+    /**
+     * @brief IREditableBlock构造函数
+     * 
+     * 复制基本块的指令与参数
+     * 
+     * @param block 基本块
+     */
+    IREditableBlock::IREditableBlock(const IRBasicBlock *block)
+        : IREditableBlock(block->GetName())
+    {
+        nodes.reserve(block->GetInsNum() + 1);
+        for (const Ins &ins : block->Instructions()) {
+            AppendIns(ins);
+        }
+        args.reserve(block->GetArgNum());
+        for (int i = 0 ; i < block->GetArgNum() ; i ++) {
+            args.push_back(block->GetArg(i));
+        }
+    }
+
+    /**
+     * @brief 获取指令数量
+     * 
+     * @return 指令数量
+     */
+    const int IREditableBlock::GetInsNum() const {
+        return insNum;
+    }
+
+    /**
+     * @brief 获取基本块名
+     * 
+     * @return 基本块名
+     */
+    const Name IREditableBlock::GetName() const {
+        return name;
+    }
+
+    /**
+     * @brief 在指令之前插入
+     * 
+     * @param handle 句柄(End()表示插入到末尾)
+     * @param ins 指令
+     * @return 新指令的句柄
+     */
+    int IREditableBlock::InsertBefore(int handle, const Ins &ins) {
+        CheckHandle(handle);
+        int node = NewNode(ins);
+        Link(node, handle);
+        return node;
+    }
+
+    /**
+     * @brief 在指令之后插入
+     * 
+     * @param handle 句柄(End()表示插入到开头)
+     * @param ins 指令
+     * @return 新指令的句柄
+     */
+    int IREditableBlock::InsertAfter(int handle, const Ins &ins) {
+        CheckHandle(handle);
+        int node = NewNode(ins);
+        Link(node, nodes[handle].next);
+        return node;
+    }
+
+    /**
+     * @brief 追加指令
+     * 
+     * @param ins 指令
+     * @return 新指令的句柄
+     */
+    int IREditableBlock::AppendIns(const Ins &ins) {
+        return InsertBefore(SENTINEL, ins);
+    }
+
+    /**
+     * @brief 删除指令
+     * 
+     * 被删除的节点标记为空闲, 之后再使用其句柄会报告错误
+     * 
+     * @param handle 句柄
+     * @return 下一条指令的句柄
+     */
+    int IREditableBlock::Erase(int handle) {
+        CheckHandle(handle);
+        if (handle == SENTINEL) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't erase the end of a block!";
+        }
+        int prev = nodes[handle].prev;
+        int next = nodes[handle].next;
+        nodes[prev].next = next;
+        nodes[next].prev = prev;
+        nodes[handle].prev = FREED_NODE;
+        nodes[handle].next = freeList;
+        freeList = handle;
+        insNum --;
+        return next;
+    }
+
+    /**
+     * @brief 压缩为IR基本块
+     * 
+     * 按链表顺序将指令复制到连续存储中
+     * 
+     * @return IR基本块
+     */
+    IRBasicBlock *IREditableBlock::Freeze() const {
+        IRBasicBlockBuilder builder;
+        builder.Reserve(insNum);
+        for (int node = First() ; node != SENTINEL ; node = Next(node)) {
+            builder.AppendIns(nodes[node].ins);
+        }
+        for (const Argument &arg : args) {
+            builder.AppendArg(arg);
+        }
+        return builder.Build(name);
+    }
+}
\ No newline at end of file
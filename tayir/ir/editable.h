@@ -0,0 +1,226 @@
+/**
+ * @file editable.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 可编辑基本块
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <utils/check.h>
+
+#include <vector>
+
+namespace tayir {
+    /**
+     * @brief 可编辑基本块
+     * 
+     * @see IRBasicBlock
+     * 
+     * 指令存放在池化节点组成的双向链表中, 节点以下标(句柄)互相引用
+     * 在任意位置前后插入与删除均为O(1), 句柄在节点被删除前保持有效
+     * 使用越界或已删除的句柄时报告错误(发布构建中只由assert检查)
+     * 编辑完成后通过Freeze()压缩回连续存储的IRBasicBlock
+     * 
+     */
+    class IREditableBlock {
+    protected:
+        /**
+         * @brief 链表节点
+         * 
+         */
+        struct Node {
+            /** 指令 */
+            Ins ins;
+            /** 前驱节点(空闲节点中为FREED_NODE) */
+            int prev;
+            /** 后继节点(空闲节点中为下一个空闲节点) */
+            int next;
+        };
+        /** 哨兵节点 */
+        static const int SENTINEL = 0;
+        /** 空闲节点的前驱标记 */
+        static const int FREED_NODE = -1;
+        /** 节点池, 0号为哨兵 */
+        std::vector<Node> nodes;
+        /** 空闲节点链表头 */
+        int freeList;
+        /** 指令数 */
+        int insNum;
+        /** 基本块名 */
+        Name name;
+        /** 基本块参数表 */
+        std::vector<Argument> args;
+        /**
+         * @brief 申请节点
+         * 
+         * @param ins 指令
+         * @return 节点
+         */
+        int NewNode(const Ins &ins);
+        /**
+         * @brief 将节点链接到pos之前
+         * 
+         * @param node 节点
+         * @param pos 位置
+         */
+        void Link(int node, int pos);
+        /**
+         * @brief 检查句柄
+         * 
+         * @param handle 句柄(End()也有效)
+         */
+        void CheckHandle(int handle) const {
+            if (TAYIR_OUT_OF_BOUND(handle, (int)nodes.size())) {
+                //TODO: throw an exception instead of const char *
+                throw "Out of boundary!";
+            }
+            if (TAYIR_CHECK_FAILED(nodes[handle].prev != FREED_NODE)) {
+                //TODO: throw an exception instead of const char *
+                throw "Stale handle!";
+            }
+        }
+    public:
+        /**
+         * @brief IREditableBlock构造函数
+         * 
+         * 空基本块
+         * 
+         * @param name 基本块名
+         */
+        IREditableBlock(Name name);
+        /**
+         * @brief IREditableBlock构造函数
+         * 
+         * 复制基本块的指令与参数
+         * 
+         * @param block 基本块
+         */
+        IREditableBlock(const IRBasicBlock *block);
+        /**
+         * @brief 获取指令数量
+         * 
+         * @return 指令数量
+         */
+        const int GetInsNum() const;
+        /**
+         * @brief 获取基本块名
+         * 
+         * @return 基本块名
+         */
+        const Name GetName() const;
+        /**
+         * @brief 获取首条指令
+         * 
+         * @return 句柄, 空块时为End()
+         */
+        const int First() const {
+            return nodes[SENTINEL].next;
+        }
+        /**
+         * @brief 获取末条指令
+         * 
+         * @return 句柄, 空块时为End()
+         */
+        const int Last() const {
+            return nodes[SENTINEL].prev;
+        }
+        /**
+         * @brief 获取尾后位置
+         * 
+         * @return 句柄
+         */
+        const int End() const {
+            return SENTINEL;
+        }
+        /**
+         * @brief 获取下一条指令
+         * 
+         * @param handle 句柄
+         * @return 句柄
+         */
+        const int Next(int handle) const {
+            CheckHandle(handle);
+            return nodes[handle].next;
+        }
+        /**
+         * @brief 获取上一条指令
+         * 
+         * @param handle 句柄
+         * @return 句柄
+         */
+        const int Prev(int handle) const {
+            CheckHandle(handle);
+            return nodes[handle].prev;
+        }
+        /**
+         * @brief 获取指令
+         * 
+         * 不做有效性检查
+         * 
+         * @param handle 句柄
+         * @return 指令
+         */
+        Ins &GetIns(int handle) {
+            return nodes[handle].ins;
+        }
+        /**
+         * @brief 获取指令
+         * 
+         * 不做有效性检查
+         * 
+         * @param handle 句柄
+         * @return 指令
+         */
+        const Ins &GetIns(int handle) const {
+            return nodes[handle].ins;
+        }
+        /**
+         * @brief 在指令之前插入
+         * 
+         * @param handle 句柄(End()表示插入到末尾)
+         * @param ins 指令
+         * @return 新指令的句柄
+         */
+        int InsertBefore(int handle, const Ins &ins);
+        /**
+         * @brief 在指令之后插入
+         * 
+         * @param handle 句柄(End()表示插入到开头)
+         * @param ins 指令
+         * @return 新指令的句柄
+         */
+        int InsertAfter(int handle, const Ins &ins);
+        /**
+         * @brief 追加指令
+         * 
+         * @param ins 指令
+         * @return 新指令的句柄
+         */
+        int AppendIns(const Ins &ins);
+        /**
+         * @brief 删除指令
+         * 
+         * 被删除的节点标记为空闲, 之后再使用其句柄会报告错误
+         * 
+         * @param handle 句柄
+         * @return 下一条指令的句柄
+         */
+        int Erase(int handle);
+        /**
+         * @brief 压缩为IR基本块
+         * 
+         * 按链表顺序将指令复制到连续存储中
+         * 
+         * @return IR基本块
+         */
+        IRBasicBlock *Freeze() const;
+    };
+}
\ No newline at end of file
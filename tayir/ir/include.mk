@@ -1,4 +1,13 @@
 objects += ./ir/ins.o
 objects += ./ir/slice.o
 objects += ./ir/type.o
-objects += ./ir/operand.o
\ No newline at end of file
+objects += ./ir/operand.o
+objects += ./ir/columns.o
+objects += ./ir/packed.o
+objects += ./ir/module.o
+objects += ./ir/defuse.o
+objects += ./ir/valuenum.o
+objects += ./ir/editable.o
+objects += ./ir/status.o
+objects += ./ir/bytecode.o
+objects += ./ir/parser.o
\ No newline at end of file
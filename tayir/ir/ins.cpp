@@ -86,66 +86,26 @@ namespace tayir {
     }
 
     /**
-     * @brief 获取指令类型
+     * @brief 打印操作数
      * 
-     * @return 指令类型
-     */
-    const InsType Ins::GetInsType() const {
-        return type;
-    }
-
-    /**
-     * @brief 获取目的数
-     * 
-     * @return 目的数
-     */
-    const int Ins::GetDestOp() const {
-        return destOp;
-    }
-
-    /**
-     * @brief 获取操作数1
-     * 
-     * @return 操作数1
-     */
-    const int Ins::GetSrc1Op() const {
-        return src1Op;
-    }
-
-    /**
-     * @brief 获取操作数2
-     * 
-     * @return 操作数2
-     */
-    const int Ins::GetSrc2Op() const {
-        return src2Op;
-    }
-
-    /**
-     * @brief 获取如果
-     * 
-     * @return 如果
-     */
-    const int Ins::GetCondOp() const {
-        return destOp;
-    }
-
-    /**
-     * @brief 获取如果
-     * 
-     * @return 如果
-     */
-    const int Ins::GetIfOp() const {
-        return src1Op;
-    }
-
-    /**
-     * @brief 获取否则
-     * 
-     * @return 否则
+     * @param pool 参数池
+     * @param op 操作数
+     * @param callArgs 所在函数的调用参数流
+     * @return 字符串
      */
-    const int Ins::GetElseOp() const {
-        return src2Op;
+    static std::string OperandToString(OperandPool &pool, int op, Span<const int> callArgs) {
+        if (! IsArgSpan(op)) {
+            return pool.ToString(op);
+        }
+        std::string str = "[";
+        const int offset = GetArgSpanOffset(op);
+        for (int i = 0 ; i < GetArgSpanCount(op) ; i ++) {
+            if (i != 0) {
+                str += ", ";
+            }
+            str += (size_t)(offset + i) < callArgs.GetSize() ? pool.ToString(callArgs[offset + i]) : "?";
+        }
+        return str + "]";
     }
 
     /**
@@ -153,31 +113,32 @@ namespace tayir {
      * 
      * @param pool 参数池
      * @param outs 输出流 
+     * @param callArgs 所在函数的调用参数流
      */
-    void Ins::PrintRawString(OperandPool &pool, std::ostream &outs) const {
+    void Ins::PrintRawString(OperandPool &pool, std::ostream &outs, Span<const int> callArgs) const {
         // 特殊: BR指令
         if (type == InsType::BR) {
             outs << ToString(type);
             if (destOp != -1) {
-                outs << " " << pool.GetOperand(destOp)->ToString(pool);
+                outs << " " << pool.ToString(destOp);
             }
             if (src1Op != -1) {
-                outs << ", " << pool.GetOperand(src1Op)->ToString(pool);
+                outs << ", " << pool.ToString(src1Op);
             }
             if (src2Op != -1) {
-                outs << ", " << pool.GetOperand(src2Op)->ToString(pool);
+                outs << ", " << pool.ToString(src2Op);
             }
         }
         else {
             if (destOp != -1) {
-                outs << pool.GetOperand(destOp)->ToString(pool) << " = ";
+                outs << pool.ToString(destOp) << " = ";
             }
             outs << ToString(type);
             if (src1Op != -1) {
-                outs << " " << pool.GetOperand(src1Op)->ToString(pool);
+                outs << " " << pool.ToString(src1Op);
             }
             if (src2Op != -1) {
-                outs << ", " << pool.GetOperand(src2Op)->ToString(pool);
+                outs << ", " << OperandToString(pool, src2Op, callArgs);
             }
         }
     }
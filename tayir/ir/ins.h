@@ -13,6 +13,7 @@
 #pragma once
 
 #include <ir/operand.h>
+#include <utils/span.h>
 #include <vector>
 
 namespace tayir {
@@ -132,49 +133,88 @@ namespace tayir {
          * 
          * @return 指令类型
          */
-        const InsType GetInsType() const;
+        const InsType GetInsType() const {
+            return type;
+        }
         /**
          * @brief 获取目的数
          * 
          * @return 目的数
          */
-        const int GetDestOp() const;
+        const int GetDestOp() const {
+            return destOp;
+        }
         /**
          * @brief 获取操作数1
          * 
          * @return 操作数1
          */
-        const int GetSrc1Op() const;
+        const int GetSrc1Op() const {
+            return src1Op;
+        }
         /**
          * @brief 获取操作数2
          * 
          * @return 操作数2
          */
-        const int GetSrc2Op() const;
+        const int GetSrc2Op() const {
+            return src2Op;
+        }
         /**
          * @brief 获取如果
          * 
          * @return 如果
          */
-        const int GetCondOp() const;
+        const int GetCondOp() const {
+            return destOp;
+        }
         /**
          * @brief 获取如果
          * 
          * @return 如果
          */
-        const int GetIfOp() const;
+        const int GetIfOp() const {
+            return src1Op;
+        }
         /**
          * @brief 获取否则
          * 
          * @return 否则
          */
-        const int GetElseOp() const;
+        const int GetElseOp() const {
+            return src2Op;
+        }
+        /**
+         * @brief 设置目的数
+         * 
+         * @param op 目的数 & 条件
+         */
+        void SetDestOp(int op) {
+            destOp = op;
+        }
+        /**
+         * @brief 设置操作数1
+         * 
+         * @param op 操作数1 & 如果
+         */
+        void SetSrc1Op(int op) {
+            src1Op = op;
+        }
+        /**
+         * @brief 设置操作数2
+         * 
+         * @param op 操作数2 & 否则
+         */
+        void SetSrc2Op(int op) {
+            src2Op = op;
+        }
         /**
          * @brief 打印
          * 
          * @param pool 参数池
          * @param outs 输出流 
+         * @param callArgs 所在函数的调用参数流
          */
-        void PrintRawString(OperandPool &pool, std::ostream &outs) const;
+        void PrintRawString(OperandPool &pool, std::ostream &outs, Span<const int> callArgs = Span<const int>()) const;
     };
 }
\ No newline at end of file
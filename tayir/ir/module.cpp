@@ -0,0 +1,216 @@
+/**
+ * @file module.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief IR模块
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/module.h>
+#include <utils/check.h>
+
+namespace tayir {
+    /**
+     * @brief IRModule构造函数
+     * 
+     * @param name 模块名
+     * @param ownInterner 是否使用模块自己的驻留表
+     */
+    IRModule::IRModule(Name name, bool ownInterner)
+        : name(name), interner(NULL), pool(OperandPoolMode::ARENA)
+    {
+        if (ownInterner) {
+            interner = new StringInterner();
+            this->name = Name::FromId(interner->Intern(name.View()));
+        }
+    }
+
+    /**
+     * @brief IRModule析构函数
+     * 
+     * 函数逐个释放; 有自己的驻留表时一并释放, 此时其InternerScope须已结束
+     * 
+     */
+    IRModule::~IRModule() {
+        for (IRFunction *func : functions) {
+            delete func;
+        }
+        functions.clear();
+        if (interner != NULL) {
+            delete interner;
+            interner = NULL;
+        }
+    }
+
+    /**
+     * @brief 获取模块名
+     * 
+     * @return 模块名
+     */
+    const Name IRModule::GetName() const {
+        return name;
+    }
+
+    /**
+     * @brief 获取模块自己的驻留表
+     * 
+     * @return 驻留表, 使用共享的驻留表时为NULL
+     */
+    StringInterner *IRModule::GetInterner() {
+        return interner;
+    }
+
+    /**
+     * @brief 获取操作数池
+     * 
+     * @return 操作数池
+     */
+    OperandPool &IRModule::GetOperandPool() {
+        return pool;
+    }
+
+    /**
+     * @brief 获取类型管理器
+     * 
+     * @return 类型管理器
+     */
+    TypeManager &IRModule::GetTypeManager() {
+        return typeManager;
+    }
+
+    /**
+     * @brief 获取函数声明表
+     * 
+     * @return 函数声明表
+     */
+    IRFuncDeclTab &IRModule::GetFuncDeclTab() {
+        return declTab;
+    }
+
+    /**
+     * @brief 追加函数
+     * 
+     * 模块接管函数的所有权, 并登记其声明
+     * 
+     * @param func 函数
+     * @return 函数下标, 函数名重复时为-1(此时函数不被接管)
+     */
+    int IRModule::AppendFunction(IRFunction *func) {
+        const Name funcName = func->GetDecl().name;
+        if (functionIndex.count(funcName) != 0) {
+            return -1;
+        }
+        int sub = functions.size();
+        functions.push_back(func);
+        functionIndex.insert(std::make_pair(funcName, sub));
+        declTab.AppendFuncDecl(func->GetDecl());
+        return sub;
+    }
+
+    /**
+     * @brief 获取函数数量
+     * 
+     * @return 函数数量
+     */
+    const int IRModule::GetFunctionNum() const {
+        return functions.size();
+    }
+
+    /**
+     * @brief 获取函数
+     * 
+     * @param sub 下标
+     * @return 函数
+     */
+    const IRFunction *IRModule::GetFunction(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)functions.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return functions[sub];
+    }
+
+    /**
+     * @brief 获取函数
+     * 
+     * @param name 函数名
+     * @return 函数, 不存在时为NULL
+     */
+    const IRFunction *IRModule::GetFunction(Name name) const {
+        auto iter = functionIndex.find(name);
+        if (iter == functionIndex.end()) {
+            return NULL;
+        }
+        return functions[iter->second];
+    }
+
+    /**
+     * @brief 获取内存统计
+     * 
+     * @return 内存统计
+     */
+    const IRModuleMemoryInfo IRModule::GetMemoryInfo() const {
+        IRModuleMemoryInfo info;
+        info.operandNum = pool.GetOperandNum();
+        info.operandBytes = pool.GetReservedBytes();
+        info.typeNum = typeManager.GetTypeNum();
+        info.funcDeclNum = declTab.GetFuncDeclNum();
+        info.funcDeclBytes = declTab.GetReservedBytes();
+        info.functionNum = functions.size();
+        info.functionBytes = sizeof(IRFunction *) * functions.capacity() + sizeof(void *) * functionIndex.bucket_count()
+            + (sizeof(std::pair<const Name, int>) + sizeof(void *)) * functionIndex.size();
+        info.blockNum = 0;
+        info.blockBytes = 0;
+        info.insNum = 0;
+        info.insBytes = 0;
+        for (const IRFunction *func : functions) {
+            info.functionBytes += func->GetReservedBytes();
+            info.blockNum += func->GetBlockNum();
+            info.insNum += func->GetInsNum();
+            for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+                const IRBasicBlock *block = func->GetBlock(i);
+                info.blockBytes += block->GetReservedBytes();
+                info.insBytes += block->GetInsReservedBytes();
+            }
+        }
+        info.nameNum = interner != NULL ? interner->GetStringNum() : 0;
+        info.nameBytes = interner != NULL ? interner->GetReservedBytes() : 0;
+        info.totalBytes = info.operandBytes + info.funcDeclBytes + info.functionBytes + info.blockBytes + info.insBytes + info.nameBytes;
+        return info;
+    }
+
+    /**
+     * @brief 打印内存统计
+     * 
+     * @param outs 输出流
+     */
+    void IRModule::PrintMemoryReport(std::ostream &outs) const {
+        const IRModuleMemoryInfo info = GetMemoryInfo();
+        outs << "module " << name << ":" << std::endl;
+        outs << "  operands:     " << info.operandNum << " (" << info.operandBytes << " bytes)" << std::endl;
+        outs << "  types:        " << info.typeNum << std::endl;
+        outs << "  declarations: " << info.funcDeclNum << " (" << info.funcDeclBytes << " bytes)" << std::endl;
+        outs << "  functions:    " << info.functionNum << " (" << info.functionBytes << " bytes)" << std::endl;
+        outs << "  blocks:       " << info.blockNum << " (" << info.blockBytes << " bytes)" << std::endl;
+        outs << "  instructions: " << info.insNum << " (" << info.insBytes << " bytes)" << std::endl;
+        if (interner != NULL) {
+            outs << "  names:        " << info.nameNum << " (" << info.nameBytes << " bytes)" << std::endl;
+        }
+        outs << "  total:        " << info.totalBytes << " bytes" << std::endl;
+    }
+
+    /**
+     * @brief 打印
+     * 
+     * @param outs 输出流
+     */
+    void IRModule::PrintRawString(std::ostream &outs) {
+        for (IRFunction *func : functions) {
+            func->PrintRawString(typeManager, pool, outs);
+        }
+    }
+}
\ No newline at end of file
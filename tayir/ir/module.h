@@ -0,0 +1,181 @@
+/**
+ * @file module.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief IR模块
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/operand.h>
+#include <ir/type.h>
+#include <ir/slice.h>
+#include <utils/interner.h>
+
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+
+namespace tayir {
+    /**
+     * @brief IR模块内存统计
+     * 
+     */
+    struct IRModuleMemoryInfo {
+        /** 操作数数量 */
+        int operandNum;
+        /** 操作数池占用字节数 */
+        size_t operandBytes;
+        /** 类型数量 */
+        int typeNum;
+        /** 函数声明数量 */
+        int funcDeclNum;
+        /** 函数声明表占用字节数 */
+        size_t funcDeclBytes;
+        /** 函数数量 */
+        int functionNum;
+        /** 函数占用字节数(含模块的函数表与索引, 不含基本块) */
+        size_t functionBytes;
+        /** 基本块数量 */
+        int blockNum;
+        /** 基本块占用字节数(不含指令表) */
+        size_t blockBytes;
+        /** 指令数量 */
+        int insNum;
+        /** 指令表占用字节数(按容量) */
+        size_t insBytes;
+        /** 名称数量(模块没有自己的驻留表时为0) */
+        int nameNum;
+        /** 模块驻留表占用字节数 */
+        size_t nameBytes;
+        /** 以上各项字节数之和 */
+        size_t totalBytes;
+    };
+
+    /**
+     * @brief IR模块
+     * 
+     * 持有一次编译所需的操作数池, 类型管理器, 函数声明表与全部函数
+     * 操作数池以Arena模式工作, 析构时整块释放
+     * 模块析构时逐个释放所有函数及其基本块(其中的容器不在Arena中)
+     * 符号, 标签, 参数等名称驻留在当前StringInterner中, 默认为全局驻留表, 由所有模块共享且不会随模块释放
+     * 模块也可以有自己的驻留表: 在InternerScope(*module.GetInterner())中构建和使用模块, 名称随模块一并释放
+     * 
+     */
+    class IRModule {
+    protected:
+        /** 模块名 */
+        Name name;
+        /** 模块自己的驻留表(为NULL时使用共享的驻留表) */
+        StringInterner *interner;
+        /** 操作数池 */
+        OperandPool pool;
+        /** 类型管理器 */
+        TypeManager typeManager;
+        /** 函数声明表 */
+        IRFuncDeclTab declTab;
+        /** 函数表 */
+        std::vector<IRFunction *> functions;
+        /** 函数名 -> 函数下标 */
+        std::unordered_map<Name, int> functionIndex;
+    public:
+        /**
+         * @brief IRModule构造函数
+         * 
+         * @param name 模块名
+         * @param ownInterner 是否使用模块自己的驻留表
+         */
+        IRModule(Name name, bool ownInterner = false);
+        /**
+         * @brief IRModule析构函数
+         * 
+         * 函数逐个释放; 有自己的驻留表时一并释放, 此时其InternerScope须已结束
+         * 
+         */
+        ~IRModule();
+        IRModule(const IRModule &) = delete;
+        IRModule &operator=(const IRModule &) = delete;
+        /**
+         * @brief 获取模块名
+         * 
+         * @return 模块名
+         */
+        const Name GetName() const;
+        /**
+         * @brief 获取模块自己的驻留表
+         * 
+         * @return 驻留表, 使用共享的驻留表时为NULL
+         */
+        StringInterner *GetInterner();
+        /**
+         * @brief 获取操作数池
+         * 
+         * @return 操作数池
+         */
+        OperandPool &GetOperandPool();
+        /**
+         * @brief 获取类型管理器
+         * 
+         * @return 类型管理器
+         */
+        TypeManager &GetTypeManager();
+        /**
+         * @brief 获取函数声明表
+         * 
+         * @return 函数声明表
+         */
+        IRFuncDeclTab &GetFuncDeclTab();
+        /**
+         * @brief 追加函数
+         * 
+         * 模块接管函数的所有权, 并登记其声明
+         * 
+         * @param func 函数
+         * @return 函数下标, 函数名重复时为-1(此时函数不被接管)
+         */
+        int AppendFunction(IRFunction *func);
+        /**
+         * @brief 获取函数数量
+         * 
+         * @return 函数数量
+         */
+        const int GetFunctionNum() const;
+        /**
+         * @brief 获取函数
+         * 
+         * @param sub 下标
+         * @return 函数
+         */
+        const IRFunction *GetFunction(int sub) const;
+        /**
+         * @brief 获取函数
+         * 
+         * @param name 函数名
+         * @return 函数, 不存在时为NULL
+         */
+        const IRFunction *GetFunction(Name name) const;
+        /**
+         * @brief 获取内存统计
+         * 
+         * @return 内存统计
+         */
+        const IRModuleMemoryInfo GetMemoryInfo() const;
+        /**
+         * @brief 打印内存统计
+         * 
+         * @param outs 输出流
+         */
+        void PrintMemoryReport(std::ostream &outs) const;
+        /**
+         * @brief 打印
+         * 
+         * @param outs 输出流
+         */
+        void PrintRawString(std::ostream &outs);
+    };
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
  */
 
 #include <ir/operand.h>
+#include <utils/check.h>
 #include <cstring>
 
 namespace tayir {
@@ -36,15 +37,6 @@ namespace tayir {
     OperandBase::~OperandBase() {
     }
 
-    /**
-     * @brief 获取操作数类型
-     * 
-     * @return 操作数类型
-     */
-    const OperandType OperandBase::GetOperandType() const {
-        return type;
-    }
-
 //----------------------
 
     /**
@@ -72,43 +64,14 @@ namespace tayir {
 //----------------------
 
     /**
-     * @brief 立即数操作数构造函数
+     * @brief 立即数转字符串
      * 
      * @param type 立即数类型
      * @param value 立即数值
      * 
-     */
-    ImmediateOperand::ImmediateOperand(const imm::itype type, const ImmediateValue value) 
-        : OperandBase(OperandType::IMMEDIATE), type(type), value(value)
-    {
-    }
-
-    /**
-     * @brief 获取立即数值
-     * 
-     * @return 立即数值
-     */
-    const ImmediateValue ImmediateOperand::GetValue() const {
-        return value;
-    }
-
-    /**
-     * @brief 获取立即数类型
-     * 
-     * @return 立即数类型
-     */
-    const imm::itype ImmediateOperand::GetType() const {
-        return type;
-    }
-
-    /**
-     * @brief 操作数转字符串
-     * 
-     * @param pool 操作数池
-     * 
      * @return 字符串
      */
-    std::string ImmediateOperand::ToString(OperandPool &pool) const {
+    static std::string ImmediateToString(const imm::itype type, const ImmediateValue value) {
         std::stringstream ss;
         switch(type) {
         case imm::itype::I8: {
@@ -182,15 +145,76 @@ namespace tayir {
         return "error!";
     }
 
+    /**
+     * @brief 立即数操作数构造函数
+     * 
+     * @param type 立即数类型
+     * @param value 立即数值
+     * 
+     */
+    ImmediateOperand::ImmediateOperand(const imm::itype type, const ImmediateValue value) 
+        : OperandBase(OperandType::IMMEDIATE), type(type), value(value)
+    {
+    }
+
+    /**
+     * @brief 获取立即数值
+     * 
+     * @return 立即数值
+     */
+    const ImmediateValue ImmediateOperand::GetValue() const {
+        return value;
+    }
+
+    /**
+     * @brief 获取立即数类型
+     * 
+     * @return 立即数类型
+     */
+    const imm::itype ImmediateOperand::GetType() const {
+        return type;
+    }
+
+    /**
+     * @brief 操作数转字符串
+     * 
+     * @param pool 操作数池
+     * 
+     * @return 字符串
+     */
+    std::string ImmediateOperand::ToString(OperandPool &pool) const {
+        return ImmediateToString(type, value);
+    }
+
 //----------------------
 
+    /**
+     * @brief 获取符号范围前缀
+     * 
+     * @param scope 符号范围
+     * 
+     * @return 前缀
+     */
+    static std::string ScopePrefix(const SymbolScope scope) {
+        if (scope == SymbolScope::GLOBAL) {
+            return "@";
+        }
+        else if (scope == SymbolScope::BUILTIN) {
+            return "#";
+        }
+        else if (scope == SymbolScope::LOCAL) {
+            return "%";
+        }
+        return "";
+    }
+
     /**
      * @brief 符号操作数构造函数
      * 
      * @param scope 符号范围
      * @param name 符号名称
      */
-    SymbolOperand::SymbolOperand(const SymbolScope scope, std::string name)
+    SymbolOperand::SymbolOperand(const SymbolScope scope, Name name)
         : OperandBase(OperandType::SYMBOL), scope(scope), name(name)
     {
     }
@@ -209,7 +233,7 @@ namespace tayir {
      * 
      * @return 符号名称
      */
-    const std::string SymbolOperand::GetName() const {
+    const Name SymbolOperand::GetName() const {
         return name;
     }
 
@@ -221,20 +245,7 @@ namespace tayir {
      * @return 字符串
      */
     std::string SymbolOperand::ToString(OperandPool &pool) const {
-        std::string str;
-        if (scope == SymbolScope::GLOBAL) {
-            str = "@";
-        }
-        else if (scope == SymbolScope::BUILTIN) {
-            str = "#";
-        }
-        else if (scope == SymbolScope::LOCAL) {
-            str = "%";
-        }
-        else {
-            str = "";
-        }
-        return str + name;
+        return ScopePrefix(scope).append(name.View());
     }
 
 //----------------------
@@ -244,7 +255,7 @@ namespace tayir {
      * 
      * @param name 标号名称
      */
-    LabelOperand::LabelOperand(std::string name)
+    LabelOperand::LabelOperand(Name name)
         : OperandBase(OperandType::LABEL), name(name)
     {
     }
@@ -254,7 +265,7 @@ namespace tayir {
      * 
      * @return 标号名称
      */
-    const std::string LabelOperand::GetName() const {
+    const Name LabelOperand::GetName() const {
         return name;
     }
 
@@ -266,7 +277,7 @@ namespace tayir {
      * @return 字符串
      */
     std::string LabelOperand::ToString(OperandPool &pool) const {
-        return name;
+        return name.ToString();
     }
 
 //----------------------
@@ -286,10 +297,39 @@ namespace tayir {
      * 
      * @return 标号名称
      */
-    const std::vector<int> ArgListOperand::GetArgList() {
+    const std::vector<int> &ArgListOperand::GetArgList() const {
         return argList;
     }
 
+    /**
+     * @brief 获取参数数量
+     * 
+     * @return 参数数量
+     */
+    const int ArgListOperand::GetArgNum() const {
+        return argList.size();
+    }
+
+    /**
+     * @brief 获取参数
+     * 
+     * @param sub 下标
+     * @return 参数操作数ID
+     */
+    const int ArgListOperand::GetArg(int sub) const {
+        return argList.at(sub);
+    }
+
+    /**
+     * @brief 设置参数
+     * 
+     * @param sub 下标
+     * @param op 参数操作数ID
+     */
+    void ArgListOperand::SetArg(int sub, int op) {
+        argList.at(sub) = op;
+    }
+
     /**
      * @brief 操作数转字符串
      * 
@@ -301,9 +341,9 @@ namespace tayir {
         std::stringstream ss;
         ss << "[";
         if (argList.size() >= 1) {
-            ss << pool.GetOperand(argList.at(0))->ToString(pool);
+            ss << pool.ToString(argList.at(0));
             for (int i = 1 ; i < (int)argList.size() ; i ++) {
-                ss << ", " << pool.GetOperand(argList.at(i))->ToString(pool);
+                ss << ", " << pool.ToString(argList.at(i));
             }
         }
         ss << "]";
@@ -315,43 +355,578 @@ namespace tayir {
     /**
      * @brief 操作数池构造函数
      * 
+     * @param mode 池模式
      */
-    OperandPool::OperandPool() {
+    OperandPool::OperandPool(OperandPoolMode mode)
+        : mode(mode), recordNum(0)
+    {
     }
 
     /**
      * @brief 操作数池析构函数
      * 
+     * ARENA模式下所有记录随Arena一次释放
+     * 
      */
     OperandPool::~OperandPool() {
         for (auto op : operands) {
             delete op;
         }
         operands.clear();
+        recordChunks.clear();
+    }
+
+    /**
+     * @brief 分配新记录
+     * 
+     * @param type 操作数类型
+     * @param subType 子类型
+     * @return 操作数ID
+     */
+    int OperandPool::NewRecord(OperandType type, int subType) {
+        const int chunkRecordNum = 1 << recordChunkShift;
+        if (recordNum >= INLINE_IMM_TAG) {
+            //TODO: throw an exception instead of const char *
+            throw "Operand pool is full!";
+        }
+        if ((recordNum & (chunkRecordNum - 1)) == 0) {
+            recordChunks.push_back(arena.AllocateArray<OperandRecord>(chunkRecordNum));
+        }
+        int id = recordNum ++;
+        OperandRecord &record = RecordAt(id);
+        record.type = type;
+        record.subType = subType;
+        record.value.ui64Val = 0;
+        return id;
+    }
+
+    /**
+     * @brief 获取池模式
+     * 
+     * @return 池模式
+     */
+    const OperandPoolMode OperandPool::GetMode() const {
+        return mode;
+    }
+
+    /**
+     * @brief 获取操作数数量
+     * 
+     * @return 操作数数量
+     */
+    const int OperandPool::GetOperandNum() const {
+        if (mode == OperandPoolMode::ARENA) {
+            return recordNum;
+        }
+        return operands.size();
     }
 
     /**
      * @brief 获取操作数
      * 
+     * 仅HEAP模式可用
+     * 
      * @param id 操作数ID
      * @return 操作数
      */
     OperandBase *OperandPool::GetOperand(int id) {
+        if (mode != OperandPoolMode::HEAP) {
+            //TODO: throw an exception instead of const char *
+            throw "GetOperand is only available in heap mode!";
+        }
         return operands.at(id);
     }
+
+    /**
+     * @brief 获取操作数记录
+     * 
+     * 仅ARENA模式可用
+     * 
+     * @param id 操作数ID
+     * @return 操作数记录
+     */
+    const OperandRecord *OperandPool::GetRecord(int id) const {
+        if (mode != OperandPoolMode::ARENA || id < 0 || id >= recordNum) {
+            return NULL;
+        }
+        return &RecordAt(id);
+    }
+
+    /**
+     * @brief 获取操作数类型
+     * 
+     * @param id 操作数ID
+     * @return 操作数类型
+     */
+    const OperandType OperandPool::GetOperandType(int id) const {
+        if (IsInlineImm(id)) {
+            return OperandType::IMMEDIATE;
+        }
+        if (mode == OperandPoolMode::ARENA) {
+            if (TAYIR_OUT_OF_BOUND(id, recordNum)) {
+                //TODO: throw an exception instead of const char *
+                throw "Out of boundary!";
+            }
+            return GetRecord(id)->type;
+        }
+        return operands.at(id)->GetOperandType();
+    }
+
+    /**
+     * @brief 获取符号或标号的名称
+     * 
+     * @param id 操作数ID
+     * @return 名称, 其他操作数返回空名称
+     */
+    const Name OperandPool::GetName(int id) const {
+        OperandType type = GetOperandType(id);
+        if (type != OperandType::SYMBOL && type != OperandType::LABEL) {
+            return Name();
+        }
+        if (mode == OperandPoolMode::ARENA) {
+            return Name::FromId(RecordAt(id).nameId);
+        }
+        if (type == OperandType::SYMBOL) {
+            return static_cast<SymbolOperand *>(operands.at(id))->GetName();
+        }
+        return static_cast<LabelOperand *>(operands.at(id))->GetName();
+    }
+
+    /**
+     * @brief 操作数转字符串
+     * 
+     * @param id 操作数ID
+     * @return 字符串
+     */
+    std::string OperandPool::ToString(int id) {
+        if (IsInlineImm(id)) {
+            return std::to_string(GetInlineImm(id));
+        }
+        if (mode == OperandPoolMode::HEAP) {
+            // 具体操作数类均为final, 经VisitOperand调用的ToString不再虚分派
+            return VisitOperand(operands.at(id), [this](auto &operand) {
+                return operand.ToString(*this);
+            });
+        }
+        if (TAYIR_OUT_OF_BOUND(id, recordNum)) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        const OperandRecord &record = RecordAt(id);
+        switch (record.type) {
+        case OperandType::EMPTY:
+            return "";
+        case OperandType::IMMEDIATE:
+            return ImmediateToString((imm::itype)record.subType, record.value);
+        case OperandType::SYMBOL:
+            return ScopePrefix((SymbolScope)record.subType).append(Name::FromId(record.nameId).View());
+        case OperandType::LABEL:
+            return Name::FromId(record.nameId).ToString();
+        case OperandType::ARGLIST: {
+            std::stringstream ss;
+            ss << "[";
+            for (int i = 0 ; i < record.subType ; i ++) {
+                if (i != 0) {
+                    ss << ", ";
+                }
+                ss << ToString(record.args[i]);
+            }
+            ss << "]";
+            return ss.str();
+        }
+        }
+        return "error!";
+    }
     
     /**
      * @brief 追加操作数
      * 
+     * ARENA模式下操作数会被转换为记录, 原对象被释放
+     * 
      * @param operand 操作数
      * @return 操作数ID
      */
     int OperandPool::AppendOperand(OperandBase *operand) {
-        int id = operands.size();
-        operands.push_back(operand);
+        if (mode == OperandPoolMode::HEAP) {
+            int id = operands.size();
+            if (id >= INLINE_IMM_TAG) {
+                //TODO: throw an exception instead of const char *
+                throw "Operand pool is full!";
+            }
+            operands.push_back(operand);
+            return id;
+        }
+        int id = -1;
+        switch (operand->GetOperandType()) {
+        case OperandType::EMPTY:
+            id = AppendEmpty();
+            break;
+        case OperandType::IMMEDIATE: {
+            ImmediateOperand *imm = static_cast<ImmediateOperand *>(operand);
+            id = AppendImmediate(imm->GetType(), imm->GetValue());
+            break;
+        }
+        case OperandType::SYMBOL: {
+            SymbolOperand *symbol = static_cast<SymbolOperand *>(operand);
+            id = AppendSymbol(symbol->GetScope(), symbol->GetName());
+            break;
+        }
+        case OperandType::LABEL:
+            id = AppendLabel(static_cast<LabelOperand *>(operand)->GetName());
+            break;
+        case OperandType::ARGLIST:
+            id = AppendArgList(static_cast<ArgListOperand *>(operand)->GetArgList());
+            break;
+        }
+        delete operand;
+        return id;
+    }
+
+    /**
+     * @brief 追加空操作数
+     * 
+     * @return 操作数ID
+     */
+    int OperandPool::AppendEmpty() {
+        if (mode == OperandPoolMode::HEAP) {
+            return AppendOperand(new EmptyOperand());
+        }
+        return NewRecord(OperandType::EMPTY, 0);
+    }
+
+    /**
+     * @brief 追加立即数操作数
+     * 
+     * @param type 立即数类型
+     * @param value 立即数值
+     * @return 操作数ID
+     */
+    int OperandPool::AppendImmediate(const imm::itype type, const ImmediateValue value) {
+        if (mode == OperandPoolMode::HEAP) {
+            return AppendOperand(new ImmediateOperand(type, value));
+        }
+        int id = NewRecord(OperandType::IMMEDIATE, (int)type);
+        RecordAt(id).value = value;
+        return id;
+    }
+
+    /**
+     * @brief 追加符号操作数
+     * 
+     * @param scope 符号范围
+     * @param name 符号名称
+     * @return 操作数ID
+     */
+    int OperandPool::AppendSymbol(const SymbolScope scope, const Name name) {
+        if (mode == OperandPoolMode::HEAP) {
+            return AppendOperand(new SymbolOperand(scope, name));
+        }
+        int id = NewRecord(OperandType::SYMBOL, (int)scope);
+        RecordAt(id).nameId = name.GetId();
+        return id;
+    }
+
+    /**
+     * @brief 追加标号操作数
+     * 
+     * @param name 标号名称
+     * @return 操作数ID
+     */
+    int OperandPool::AppendLabel(const Name name) {
+        if (mode == OperandPoolMode::HEAP) {
+            return AppendOperand(new LabelOperand(name));
+        }
+        int id = NewRecord(OperandType::LABEL, 0);
+        RecordAt(id).nameId = name.GetId();
+        return id;
+    }
+
+    /**
+     * @brief 追加参数列表操作数
+     * 
+     * @param argList 参数列表
+     * @return 操作数ID
+     */
+    int OperandPool::AppendArgList(const std::vector<int> &argList) {
+        if (mode == OperandPoolMode::HEAP) {
+            return AppendOperand(new ArgListOperand(argList));
+        }
+        int *args = arena.AllocateArray<int>(argList.size());
+        for (int i = 0 ; i < (int)argList.size() ; i ++) {
+            args[i] = argList.at(i);
+        }
+        int id = NewRecord(OperandType::ARGLIST, argList.size());
+        RecordAt(id).args = args;
+        return id;
+    }
+
+    /**
+     * @brief 获取参数列表的参数数量
+     * 
+     * @param id 参数列表操作数ID
+     * @return 参数数量
+     */
+    const int OperandPool::GetArgNum(int id) const {
+        if (GetOperandType(id) != OperandType::ARGLIST) {
+            //TODO: throw an exception instead of const char *
+            throw "Not an argument list!";
+        }
+        if (mode == OperandPoolMode::ARENA) {
+            return RecordAt(id).subType;
+        }
+        return static_cast<ArgListOperand *>(operands.at(id))->GetArgNum();
+    }
+
+    /**
+     * @brief 获取参数列表的参数
+     * 
+     * @param id 参数列表操作数ID
+     * @param sub 下标
+     * @return 参数操作数ID
+     */
+    const int OperandPool::GetArg(int id, int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, GetArgNum(id))) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        if (mode == OperandPoolMode::ARENA) {
+            return RecordAt(id).args[sub];
+        }
+        return static_cast<ArgListOperand *>(operands.at(id))->GetArg(sub);
+    }
+
+    /**
+     * @brief 设置参数列表的参数
+     * 
+     * 参数列表被多条指令共享时, 修改对所有指令可见
+     * 
+     * @param id 参数列表操作数ID
+     * @param sub 下标
+     * @param op 参数操作数ID
+     */
+    void OperandPool::SetArg(int id, int sub, int op) {
+        if (TAYIR_OUT_OF_BOUND(sub, GetArgNum(id))) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        if (mode == OperandPoolMode::ARENA) {
+            RecordAt(id).args[sub] = op;
+            return;
+        }
+        static_cast<ArgListOperand *>(operands.at(id))->SetArg(sub, op);
+    }
+
+    /**
+     * @brief 计算哈希
+     * 
+     * @param key 驻留键
+     * @return 哈希值
+     */
+    size_t OperandPool::InternKeyHash::operator()(const InternKey &key) const {
+        size_t hash = std::hash<qword>()(key.bits);
+        hash ^= ((size_t)key.type << 8 | (size_t)key.subType) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    /**
+     * @brief 查找驻留操作数
+     * 
+     * @param key 驻留键
+     * @return 操作数ID, 不存在时为-1
+     */
+    int OperandPool::FindInterned(const InternKey &key) const {
+        auto iter = internTab.find(key);
+        if (iter == internTab.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取立即数的位模式
+     * 
+     * 只保留该类型实际占用的位, 使联合体中未使用的位不影响比较
+     * 
+     * @param type 立即数类型
+     * @param value 立即数值
+     * @return 位模式
+     */
+    static qword ImmediateBits(const imm::itype type, const ImmediateValue value) {
+        switch (type) {
+        case imm::itype::I8:
+        case imm::itype::UI8:
+            return value.ui8Val;
+        case imm::itype::BOOL:
+            return value.boolVal ? 1 : 0;
+        case imm::itype::I16:
+        case imm::itype::UI16:
+        case imm::itype::P16:
+            return value.ui16Val;
+        case imm::itype::I32:
+        case imm::itype::UI32:
+        case imm::itype::P32:
+        case imm::itype::FLOAT:
+            return value.ui32Val;
+        default:
+            return value.ui64Val;
+        }
+    }
+
+    /**
+     * @brief 获取或追加立即数操作数
+     * 
+     * 相同类型与值的立即数共享同一ID
+     * 
+     * @param type 立即数类型
+     * @param value 立即数值
+     * @return 操作数ID
+     */
+    int OperandPool::GetOrAddImmediate(const imm::itype type, const ImmediateValue value) {
+        InternKey key = {OperandType::IMMEDIATE, (int)type, ImmediateBits(type, value)};
+        int id = FindInterned(key);
+        if (id == -1) {
+            id = AppendImmediate(type, value);
+            internTab.insert(std::make_pair(key, id));
+        }
+        return id;
+    }
+
+    /**
+     * @brief 获取或追加i32立即数操作数
+     * 
+     * 能内联时直接返回内联立即数, 否则驻留到池中
+     * 
+     * @param value 立即数值
+     * @return 操作数
+     */
+    int OperandPool::GetOrAddInt(const imm::i32_t value) {
+        if (FitsInlineImm(value)) {
+            return MakeInlineImm(value);
+        }
+        return GetOrAddImmediate(imm::itype::I32, ImmediateValue{.i32Val = value});
+    }
+
+    /**
+     * @brief 获取或追加符号操作数
+     * 
+     * 相同范围与名称的符号共享同一ID
+     * 
+     * @param scope 符号范围
+     * @param name 符号名称
+     * @return 操作数ID
+     */
+    int OperandPool::GetOrAddSymbol(const SymbolScope scope, const Name name) {
+        InternKey key = {OperandType::SYMBOL, (int)scope, name.GetId()};
+        int id = FindInterned(key);
+        if (id == -1) {
+            id = AppendSymbol(scope, name);
+            internTab.insert(std::make_pair(key, id));
+        }
+        return id;
+    }
+
+    /**
+     * @brief 获取或追加标号操作数
+     * 
+     * 相同名称的标号共享同一ID
+     * 
+     * @param name 标号名称
+     * @return 操作数ID
+     */
+    int OperandPool::GetOrAddLabel(const Name name) {
+        InternKey key = {OperandType::LABEL, 0, name.GetId()};
+        int id = FindInterned(key);
+        if (id == -1) {
+            id = AppendLabel(name);
+            internTab.insert(std::make_pair(key, id));
+        }
         return id;
     }
 
+    /**
+     * @brief 查找符号操作数
+     * 
+     * 只查找经GetOrAddSymbol驻留的符号
+     * 
+     * @param scope 符号范围
+     * @param name 符号名称
+     * @return 操作数ID, 不存在时为-1
+     */
+    const int OperandPool::FindSymbol(const SymbolScope scope, const Name name) const {
+        return FindInterned(InternKey{OperandType::SYMBOL, (int)scope, name.GetId()});
+    }
+
+    /**
+     * @brief 从另一个操作数池导入操作数
+     * 
+     * 立即数, 符号与标号按内容获取或追加; 参数表的参数一并导入
+     * 
+     * @param other 另一个操作数池
+     * @param id 操作数在other中的ID
+     * @return 操作数在本池中的ID
+     */
+    int OperandPool::Import(OperandPool &other, int id) {
+        const bool arena = other.GetMode() == OperandPoolMode::ARENA;
+        switch (other.GetOperandType(id)) {
+        case OperandType::IMMEDIATE: {
+            const imm::itype type = arena ? (imm::itype)other.GetRecord(id)->subType
+                : static_cast<ImmediateOperand *>(other.GetOperand(id))->GetType();
+            const ImmediateValue value = arena ? other.GetRecord(id)->value
+                : static_cast<ImmediateOperand *>(other.GetOperand(id))->GetValue();
+            return GetOrAddImmediate(type, value);
+        }
+        case OperandType::SYMBOL: {
+            const SymbolScope scope = arena ? (SymbolScope)other.GetRecord(id)->subType
+                : static_cast<SymbolOperand *>(other.GetOperand(id))->GetScope();
+            return GetOrAddSymbol(scope, other.GetName(id));
+        }
+        case OperandType::LABEL:
+            return GetOrAddLabel(other.GetName(id));
+        case OperandType::ARGLIST: {
+            std::vector<int> argList(other.GetArgNum(id));
+            for (int i = 0 ; i < (int)argList.size() ; i ++) {
+                const int arg = other.GetArg(id, i);
+                argList[i] = (arg < 0 || IsInlineImm(arg)) ? arg : Import(other, arg);
+            }
+            return AppendArgList(argList);
+        }
+        case OperandType::EMPTY:
+        default:
+            return AppendEmpty();
+        }
+    }
+
+    /**
+     * @brief 获取Arena占用字节数
+     * 
+     * @return Arena占用字节数
+     */
+    const size_t OperandPool::GetArenaBytes() const {
+        return arena.GetReservedBytes();
+    }
+
+    /**
+     * @brief 获取占用字节数
+     * 
+     * Arena, 堆上的操作数对象, 各表的容量; 驻留表的节点按值加一个指针估算
+     * 
+     * @return 占用字节数
+     */
+    const size_t OperandPool::GetReservedBytes() const {
+        size_t bytes = arena.GetReservedBytes() + sizeof(OperandBase *) * operands.capacity()
+            + sizeof(OperandRecord *) * recordChunks.capacity() + sizeof(void *) * internTab.bucket_count()
+            + (sizeof(std::pair<const InternKey, int>) + sizeof(void *)) * internTab.size();
+        for (const OperandBase *operand : operands) {
+            bytes += VisitOperand(operand, [](auto &concrete) {
+                return sizeof(concrete);
+            });
+            if (operand->GetOperandType() == OperandType::ARGLIST) {
+                bytes += sizeof(int) * static_cast<const ArgListOperand *>(operand)->GetArgList().capacity();
+            }
+        }
+        return bytes;
+    }
+
 //---------------------------------------------------------
 //|                                                       |
 //|                       argument                        |
@@ -364,7 +939,7 @@ namespace tayir {
      * 
      */
     Argument::Argument()
-        : typeId(-1), name("")
+        : typeId(-1), name()
     {
     }
 
@@ -374,7 +949,7 @@ namespace tayir {
      * @param typeId 类型ID
      * @param name 名称
      */
-    Argument::Argument(const int typeId, std::string name) 
+    Argument::Argument(const int typeId, Name name) 
         : typeId(typeId), name(name)
     {
     }
@@ -392,7 +967,7 @@ namespace tayir {
      * 
      * @return 名称
      */
-    std::string Argument::GetName() const {
+    const Name Argument::GetName() const {
         return name;
     }
 }
\ No newline at end of file
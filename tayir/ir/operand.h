@@ -15,8 +15,13 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <unordered_map>
+#include <type_traits>
 
 #include <ir/type.h>
+#include <utils/types.h>
+#include <utils/interner.h>
+#include <utils/arena.h>
 
 namespace tayir {
     /**
@@ -69,7 +74,9 @@ namespace tayir {
          * 
          * @return 操作数类型
          */
-        const OperandType GetOperandType() const;
+        const OperandType GetOperandType() const {
+            return type;
+        }
         /**
          * @brief 操作数转字符串
          * 
@@ -85,7 +92,7 @@ namespace tayir {
      * @see OperandBase
      * 
      */
-    class EmptyOperand : public OperandBase{
+    class EmptyOperand final : public OperandBase {
     public:
         /**
          * @brief 空操作数构造函数
@@ -147,7 +154,7 @@ namespace tayir {
      * @see OperandBase
      * 
      */
-    class ImmediateOperand : public OperandBase {
+    class ImmediateOperand final : public OperandBase {
     protected:
         /** 立即数类型 */
         imm::itype type;
@@ -202,12 +209,12 @@ namespace tayir {
      * @see OperandBase
      * 
      */
-    class SymbolOperand : public OperandBase {
+    class SymbolOperand final : public OperandBase {
     protected:
         /** 符号范围 */
         SymbolScope scope;
         /** 符号名称 */
-        std::string name;
+        Name name;
     public:
         /**
          * @brief 符号操作数构造函数
@@ -215,7 +222,7 @@ namespace tayir {
          * @param scope 符号范围
          * @param name 符号名称
          */
-        SymbolOperand(const SymbolScope scope, std::string name);
+        SymbolOperand(const SymbolScope scope, Name name);
         /**
          * @brief 获取符号范围
          * 
@@ -227,7 +234,7 @@ namespace tayir {
          * 
          * @return 符号名称
          */
-        const std::string GetName() const;
+        const Name GetName() const;
         /**
          * @brief 操作数转字符串
          * 
@@ -242,23 +249,23 @@ namespace tayir {
      * @see OperandBase
      * 
      */
-    class LabelOperand : public OperandBase {
+    class LabelOperand final : public OperandBase {
     protected:
         /**  标号名称 */
-        std::string name;
+        Name name;
     public:
         /**
          * @brief 标号操作数构造函数
          * 
          * @param name 标号名称
          */
-        LabelOperand(std::string name);
+        LabelOperand(Name name);
         /**
          * @brief 获取标号名称
          * 
          * @return 标号名称
          */
-        const std::string GetName() const;
+        const Name GetName() const;
         /**
          * @brief 操作数转字符串
          * 
@@ -275,7 +282,7 @@ namespace tayir {
      * @see OperandBase
      * 
      */
-    class ArgListOperand : public OperandBase {
+    class ArgListOperand final : public OperandBase {
     protected:
         /**  标号名称 */
         std::vector<int> argList;
@@ -291,7 +298,27 @@ namespace tayir {
          * 
          * @return 标号名称
          */
-        const std::vector<int> GetArgList();
+        const std::vector<int> &GetArgList() const;
+        /**
+         * @brief 获取参数数量
+         * 
+         * @return 参数数量
+         */
+        const int GetArgNum() const;
+        /**
+         * @brief 获取参数
+         * 
+         * @param sub 下标
+         * @return 参数操作数ID
+         */
+        const int GetArg(int sub) const;
+        /**
+         * @brief 设置参数
+         * 
+         * @param sub 下标
+         * @param op 参数操作数ID
+         */
+        void SetArg(int sub, int op);
         /**
          * @brief 操作数转字符串
          * 
@@ -302,39 +329,469 @@ namespace tayir {
         virtual std::string ToString(OperandPool &pool) const override final;
     };
 
+    /**
+     * @brief 访问操作数
+     * 
+     * 按操作数类型switch后以具体类型调用visitor, 不经过虚函数
+     * visitor须能以每种具体操作数类型调用, 且返回类型一致
+     * operand为const指针时visitor得到的也是const引用
+     * 
+     * @tparam Base 操作数基类类型, 为OperandBase或const OperandBase
+     * @tparam Visitor 访问器类型
+     * @param operand 操作数
+     * @param visitor 访问器
+     * @return visitor的返回值
+     */
+    template<typename Base, typename Visitor> decltype(auto) VisitOperand(Base *operand, Visitor &&visitor) {
+        static_assert(std::is_same<typename std::remove_const<Base>::type, OperandBase>::value, "VisitOperand takes an OperandBase pointer");
+        // 具体类型沿用Base的const限定
+        using Immediate = typename std::conditional<std::is_const<Base>::value, const ImmediateOperand, ImmediateOperand>::type;
+        using Symbol    = typename std::conditional<std::is_const<Base>::value, const SymbolOperand, SymbolOperand>::type;
+        using Label     = typename std::conditional<std::is_const<Base>::value, const LabelOperand, LabelOperand>::type;
+        using ArgList   = typename std::conditional<std::is_const<Base>::value, const ArgListOperand, ArgListOperand>::type;
+        using Empty     = typename std::conditional<std::is_const<Base>::value, const EmptyOperand, EmptyOperand>::type;
+        switch (operand->GetOperandType()) {
+        case OperandType::IMMEDIATE:
+            return visitor(*static_cast<Immediate *>(operand));
+        case OperandType::SYMBOL:
+            return visitor(*static_cast<Symbol *>(operand));
+        case OperandType::LABEL:
+            return visitor(*static_cast<Label *>(operand));
+        case OperandType::ARGLIST:
+            return visitor(*static_cast<ArgList *>(operand));
+        case OperandType::EMPTY:
+        default:
+            return visitor(*static_cast<Empty *>(operand));
+        }
+    }
+
+    /**
+     * @brief 操作数池模式
+     * @see OperandPool
+     * 
+     */
+    enum class OperandPoolMode {
+        /** 每个操作数单独在堆上分配 */
+        HEAP  = 0,
+        /** 操作数以带标签记录的形式连续存放在Arena中 */
+        ARENA = 1
+    };
+
+    /**
+     * @brief 操作数记录
+     * 
+     * ARENA模式下操作数的存储形式
+     * 通过type标签区分操作数种类, 不含虚函数表
+     * 
+     * @see OperandPool
+     * 
+     */
+    struct OperandRecord {
+        /** 操作数类型 */
+        OperandType type;
+        /** 立即数类型 / 符号范围 / 参数数量 */
+        int subType;
+        union {
+            /** 立即数值 */
+            ImmediateValue value;
+            /** 符号名称 / 标号名称 */
+            NameId nameId;
+            /** 参数列表 */
+            int *args;
+        };
+    };
+
+    /**
+     * @brief 内联立即数标记
+     * 
+     * 指令中的操作数为非负整数且该位为1时, 其低30位直接存放一个有符号立即数,
+     * 不占用操作数池, 因此操作数池ID必须小于2^30
+     * 
+     */
+    static const int INLINE_IMM_TAG = 0x40000000;
+    /** 内联立即数最小值 */
+    static const int INLINE_IMM_MIN = -(1 << 29);
+    /** 内联立即数最大值 */
+    static const int INLINE_IMM_MAX = (1 << 29) - 1;
+
+    /**
+     * @brief 是否为内联立即数
+     * 
+     * @param op 操作数
+     * @return 是否为内联立即数
+     */
+    inline bool IsInlineImm(int op) {
+        return op >= 0 && (op & INLINE_IMM_TAG) != 0;
+    }
+
+    /**
+     * @brief 立即数能否内联
+     * 
+     * @param value 立即数值
+     * @return 能否内联
+     */
+    inline bool FitsInlineImm(long long value) {
+        return value >= INLINE_IMM_MIN && value <= INLINE_IMM_MAX;
+    }
+
+    /**
+     * @brief 构造内联立即数
+     * 
+     * @param value 立即数值(须满足FitsInlineImm)
+     * @return 操作数
+     */
+    inline int MakeInlineImm(int value) {
+        return INLINE_IMM_TAG | (int)((unsigned int)value & 0x3FFFFFFF);
+    }
+
+    /**
+     * @brief 获取内联立即数值
+     * 
+     * @param op 操作数
+     * @return 立即数值
+     */
+    inline int GetInlineImm(int op) {
+        // 符号扩展低30位
+        return (int)((unsigned int)op << 2) >> 2;
+    }
+
+    /**
+     * @brief 调用参数段
+     * 
+     * call指令的操作数2可以是一个调用参数段, 引用所在函数的调用参数流中的(偏移, 数量)
+     * 参数段为小于-1的负数: 第31位为1, 第8~30位为偏移, 第0~7位为数量
+     * 
+     * @see IRFunction::GetCallArgs
+     * 
+     */
+    static const int ARG_SPAN_MAX_COUNT = 0xFF;
+    /** 参数段最大偏移(全1被-1占用) */
+    static const int ARG_SPAN_MAX_OFFSET = 0x7FFFFE;
+
+    /**
+     * @brief 是否为调用参数段
+     * 
+     * @param op 操作数
+     * @return 是否为调用参数段
+     */
+    inline bool IsArgSpan(int op) {
+        return op < -1;
+    }
+
+    /**
+     * @brief 构造调用参数段
+     * 
+     * @param offset 偏移(不超过ARG_SPAN_MAX_OFFSET)
+     * @param count 数量(不超过ARG_SPAN_MAX_COUNT)
+     * @return 操作数
+     */
+    inline int MakeArgSpan(int offset, int count) {
+        return (int)(0x80000000u | ((unsigned int)offset << 8) | (unsigned int)count);
+    }
+
+    /**
+     * @brief 获取调用参数段偏移
+     * 
+     * @param op 操作数
+     * @return 偏移
+     */
+    inline int GetArgSpanOffset(int op) {
+        return ((unsigned int)op >> 8) & 0x7FFFFF;
+    }
+
+    /**
+     * @brief 获取调用参数段数量
+     * 
+     * @param op 操作数
+     * @return 数量
+     */
+    inline int GetArgSpanCount(int op) {
+        return (unsigned int)op & 0xFF;
+    }
+
     /**
      * @brief 操作数池
      * 
      */
     class OperandPool {
     protected:
-        /** 操作数列表 */
+        /** 每个记录块中的记录数(2^recordChunkShift) */
+        static const int recordChunkShift = 10;
+        /** 池模式 */
+        const OperandPoolMode mode;
+        /** 操作数列表(HEAP模式) */
         std::vector<OperandBase *> operands;
+        /** 记录块列表(ARENA模式) */
+        std::vector<OperandRecord *> recordChunks;
+        /** 记录数(ARENA模式) */
+        int recordNum;
+        /** 内存池(ARENA模式) */
+        Arena arena;
+        /**
+         * @brief 驻留键
+         * 
+         */
+        struct InternKey {
+            /** 操作数类型 */
+            OperandType type;
+            /** 立即数类型 / 符号范围 */
+            int subType;
+            /** 立即数位模式 / 名称ID */
+            qword bits;
+            /**
+             * @brief 判等
+             * 
+             * @param other 另一个键
+             * @return 是否相等
+             */
+            bool operator==(const InternKey &other) const {
+                return type == other.type && subType == other.subType && bits == other.bits;
+            }
+        };
+        /**
+         * @brief 驻留键哈希
+         * 
+         */
+        struct InternKeyHash {
+            /**
+             * @brief 计算哈希
+             * 
+             * @param key 驻留键
+             * @return 哈希值
+             */
+            size_t operator()(const InternKey &key) const;
+        };
+        /** 驻留索引 */
+        std::unordered_map<InternKey, int, InternKeyHash> internTab;
+        /**
+         * @brief 查找驻留操作数
+         * 
+         * @param key 驻留键
+         * @return 操作数ID, 不存在时为-1
+         */
+        int FindInterned(const InternKey &key) const;
+        /**
+         * @brief 分配新记录
+         * 
+         * @param type 操作数类型
+         * @param subType 子类型
+         * @return 操作数ID
+         */
+        int NewRecord(OperandType type, int subType);
+        /**
+         * @brief 获取记录
+         * 
+         * @param id 操作数ID
+         * @return 记录
+         */
+        OperandRecord &RecordAt(int id) const {
+            return recordChunks[id >> recordChunkShift][id & ((1 << recordChunkShift) - 1)];
+        }
     public:
         /**
          * @brief 操作数池构造函数
          * 
+         * @param mode 池模式
          */
-        OperandPool();
+        OperandPool(OperandPoolMode mode = OperandPoolMode::HEAP);
         /**
          * @brief 操作数池析构函数
          * 
          */
         ~OperandPool();
+        /**
+         * @brief 获取池模式
+         * 
+         * @return 池模式
+         */
+        const OperandPoolMode GetMode() const;
+        /**
+         * @brief 获取操作数数量
+         * 
+         * @return 操作数数量
+         */
+        const int GetOperandNum() const;
         /**
          * @brief 获取操作数
          * 
+         * 仅HEAP模式可用
+         * 
          * @param id 操作数ID
          * @return 操作数
          */
         OperandBase *GetOperand(int id);
+        /**
+         * @brief 获取操作数记录
+         * 
+         * 仅ARENA模式可用
+         * 
+         * @param id 操作数ID
+         * @return 操作数记录
+         */
+        const OperandRecord *GetRecord(int id) const;
+        /**
+         * @brief 获取操作数类型
+         * 
+         * @param id 操作数ID
+         * @return 操作数类型
+         */
+        const OperandType GetOperandType(int id) const;
+        /**
+         * @brief 获取符号或标号的名称
+         * 
+         * @param id 操作数ID
+         * @return 名称, 其他操作数返回空名称
+         */
+        const Name GetName(int id) const;
+        /**
+         * @brief 操作数转字符串
+         * 
+         * @param id 操作数ID
+         * @return 字符串
+         */
+        std::string ToString(int id);
         /**
          * @brief 追加操作数
          * 
+         * ARENA模式下操作数会被转换为记录, 原对象被释放
+         * 
          * @param operand 操作数
          * @return 操作数ID
          */
         int AppendOperand(OperandBase *operand);
+        /**
+         * @brief 追加空操作数
+         * 
+         * @return 操作数ID
+         */
+        int AppendEmpty();
+        /**
+         * @brief 追加立即数操作数
+         * 
+         * @param type 立即数类型
+         * @param value 立即数值
+         * @return 操作数ID
+         */
+        int AppendImmediate(const imm::itype type, const ImmediateValue value);
+        /**
+         * @brief 追加符号操作数
+         * 
+         * @param scope 符号范围
+         * @param name 符号名称
+         * @return 操作数ID
+         */
+        int AppendSymbol(const SymbolScope scope, const Name name);
+        /**
+         * @brief 追加标号操作数
+         * 
+         * @param name 标号名称
+         * @return 操作数ID
+         */
+        int AppendLabel(const Name name);
+        /**
+         * @brief 追加参数列表操作数
+         * 
+         * @param argList 参数列表
+         * @return 操作数ID
+         */
+        int AppendArgList(const std::vector<int> &argList);
+        /**
+         * @brief 获取参数列表的参数数量
+         * 
+         * @param id 参数列表操作数ID
+         * @return 参数数量
+         */
+        const int GetArgNum(int id) const;
+        /**
+         * @brief 获取参数列表的参数
+         * 
+         * @param id 参数列表操作数ID
+         * @param sub 下标
+         * @return 参数操作数ID
+         */
+        const int GetArg(int id, int sub) const;
+        /**
+         * @brief 设置参数列表的参数
+         * 
+         * 参数列表被多条指令共享时, 修改对所有指令可见
+         * 
+         * @param id 参数列表操作数ID
+         * @param sub 下标
+         * @param op 参数操作数ID
+         */
+        void SetArg(int id, int sub, int op);
+        /**
+         * @brief 获取或追加立即数操作数
+         * 
+         * 相同类型与值的立即数共享同一ID
+         * 
+         * @param type 立即数类型
+         * @param value 立即数值
+         * @return 操作数ID
+         */
+        int GetOrAddImmediate(const imm::itype type, const ImmediateValue value);
+        /**
+         * @brief 获取或追加i32立即数操作数
+         * 
+         * 能内联时直接返回内联立即数, 否则驻留到池中
+         * 
+         * @param value 立即数值
+         * @return 操作数
+         */
+        int GetOrAddInt(const imm::i32_t value);
+        /**
+         * @brief 获取或追加符号操作数
+         * 
+         * 相同范围与名称的符号共享同一ID
+         * 
+         * @param scope 符号范围
+         * @param name 符号名称
+         * @return 操作数ID
+         */
+        int GetOrAddSymbol(const SymbolScope scope, const Name name);
+        /**
+         * @brief 获取或追加标号操作数
+         * 
+         * 相同名称的标号共享同一ID
+         * 
+         * @param name 标号名称
+         * @return 操作数ID
+         */
+        int GetOrAddLabel(const Name name);
+        /**
+         * @brief 查找符号操作数
+         * 
+         * 只查找经GetOrAddSymbol驻留的符号
+         * 
+         * @param scope 符号范围
+         * @param name 符号名称
+         * @return 操作数ID, 不存在时为-1
+         */
+        const int FindSymbol(const SymbolScope scope, const Name name) const;
+        /**
+         * @brief 从另一个操作数池导入操作数
+         * 
+         * 立即数, 符号与标号按内容获取或追加; 参数表的参数一并导入
+         * 
+         * @param other 另一个操作数池
+         * @param id 操作数在other中的ID
+         * @return 操作数在本池中的ID
+         */
+        int Import(OperandPool &other, int id);
+        /**
+         * @brief 获取Arena占用字节数
+         * 
+         * @return Arena占用字节数
+         */
+        const size_t GetArenaBytes() const;
+        /**
+         * @brief 获取占用字节数
+         * 
+         * Arena, 堆上的操作数对象, 各表的容量; 驻留表的节点按值加一个指针估算
+         * 
+         * @return 占用字节数
+         */
+        const size_t GetReservedBytes() const;
     };
 
     /**
@@ -349,7 +806,7 @@ namespace tayir {
         /** 类型Id */
         int typeId;
         /** 名称 */
-        std::string name;
+        Name name;
     public:
         /**
          * @brief Argument构造函数
@@ -364,7 +821,7 @@ namespace tayir {
          * @param typeId 类型ID
          * @param name 名称
          */
-        Argument(const int typeId, std::string name);
+        Argument(const int typeId, Name name);
         /**
          * @brief 获取类型ID
          * 
@@ -376,6 +833,6 @@ namespace tayir {
          * 
          * @return 名称
          */
-        std::string GetName() const;
+        const Name GetName() const;
     };
 }
\ No newline at end of file
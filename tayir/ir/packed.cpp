@@ -0,0 +1,200 @@
+/**
+ * @file packed.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 紧凑指令编码
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/packed.h>
+#include <utils/check.h>
+
+namespace tayir {
+    static_assert(sizeof(PackedIns) == 8, "PackedIns must be 8 bytes");
+
+    /**
+     * @brief 编码操作数
+     * 
+     * @param op 操作数
+     * @return 字段
+     */
+    qword PackedIns::PackOp(int op) {
+        if (op == -1) {
+            return FIELD_EMPTY;
+        }
+        if (IsInlineImm(op)) {
+            return FIELD_IMM_TAG | ((qword)(unsigned int)GetInlineImm(op) & (FIELD_IMM_TAG - 1));
+        }
+        return (qword)op;
+    }
+
+    /**
+     * @brief 解码操作数
+     * 
+     * @param field 字段
+     * @return 操作数
+     */
+    int PackedIns::UnpackOp(qword field) {
+        if (field == FIELD_EMPTY) {
+            return -1;
+        }
+        if ((field & FIELD_IMM_TAG) != 0) {
+            // 符号扩展低17位
+            int value = (int)((unsigned int)field << (32 - FIELD_BITS + 1)) >> (32 - FIELD_BITS + 1);
+            return MakeInlineImm(value);
+        }
+        return (int)field;
+    }
+
+    /**
+     * @brief PackedIns构造函数
+     * 
+     * 构造NOP指令
+     * 
+     */
+    PackedIns::PackedIns()
+        : PackedIns(Ins())
+    {
+    }
+
+    /**
+     * @brief PackedIns构造函数
+     * 
+     * @param ins 指令(须满足CanPack)
+     */
+    PackedIns::PackedIns(const Ins &ins)
+        : bits((qword)ins.GetInsType()
+            | (PackOp(ins.GetDestOp()) << 8)
+            | (PackOp(ins.GetSrc1Op()) << (8 + FIELD_BITS)))
+    {
+        const int src2 = ins.GetSrc2Op();
+        if (IsArgSpan(src2)) {
+            const qword field = ((qword)GetArgSpanOffset(src2) << 8) | (qword)GetArgSpanCount(src2);
+            bits |= ARG_SPAN_FLAG | (field << (8 + FIELD_BITS * 2));
+        }
+        else {
+            bits |= PackOp(src2) << (8 + FIELD_BITS * 2);
+        }
+    }
+
+    /**
+     * @brief 操作数能否编码
+     * 
+     * @param op 操作数
+     * @return 能否编码
+     */
+    const bool PackedIns::CanPackOp(int op) {
+        if (op == -1) {
+            return true;
+        }
+        if (IsInlineImm(op)) {
+            int value = GetInlineImm(op);
+            return value >= FIELD_IMM_MIN && value <= FIELD_IMM_MAX;
+        }
+        return op >= 0 && (qword)op < FIELD_EMPTY;
+    }
+
+    /**
+     * @brief 指令能否编码
+     * 
+     * @param ins 指令
+     * @return 能否编码
+     */
+    const bool PackedIns::CanPack(const Ins &ins) {
+        const int src2 = ins.GetSrc2Op();
+        const bool src2Packable = IsArgSpan(src2) ? GetArgSpanOffset(src2) <= FIELD_ARG_SPAN_MAX_OFFSET : CanPackOp(src2);
+        return CanPackOp(ins.GetDestOp()) && CanPackOp(ins.GetSrc1Op()) && src2Packable;
+    }
+
+    /**
+     * @brief 解码为指令
+     * 
+     * @return 指令
+     */
+    const Ins PackedIns::Unpack() const {
+        return Ins(GetInsType(), GetDestOp(), GetSrc1Op(), GetSrc2Op());
+    }
+
+//--------------------------------------
+
+    /**
+     * @brief IRPackedFragment构造函数
+     * 
+     * @param slice 源切片(须满足CanPack)
+     */
+    IRPackedFragment::IRPackedFragment(const IRSlice &slice)
+        : insNum(slice.GetInsNum()), instructions(new PackedIns[insNum])
+    {
+        for (int i = 0 ; i < insNum ; i ++) {
+            const Ins ins = slice.GetIns(i);
+            if (! PackedIns::CanPack(ins)) {
+                delete[] instructions;
+                //TODO: throw an exception instead of const char *
+                throw "Instruction can't be packed!";
+            }
+            instructions[i] = PackedIns(ins);
+        }
+    }
+
+    /**
+     * @brief IRPackedFragment析构函数
+     * 
+     */
+    IRPackedFragment::~IRPackedFragment() {
+        if (instructions != NULL) {
+            delete[] instructions;
+            instructions = NULL;
+        }
+    }
+
+    /**
+     * @brief 切片能否编码
+     * 
+     * @param slice 切片
+     * @return 能否编码
+     */
+    const bool IRPackedFragment::CanPack(const IRSlice &slice) {
+        for (int i = 0 ; i < slice.GetInsNum() ; i ++) {
+            if (! PackedIns::CanPack(slice.GetIns(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 获取指令数量
+     * 
+     * @return 指令数量
+     */
+    const int IRPackedFragment::GetInsNum() const {
+        return insNum;
+    }
+
+    /**
+     * @brief 获取指令
+     * 
+     * @param sub 下标
+     * @return 指令
+     */
+    const Ins IRPackedFragment::GetIns(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, insNum)) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return instructions[sub].Unpack();
+    }
+
+    /**
+     * @brief 获取指令占用字节数
+     * 
+     * @return 字节数
+     */
+    const size_t IRPackedFragment::GetByteSize() const {
+        return sizeof(PackedIns) * insNum;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+ * @file packed.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 紧凑指令编码
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/slice.h>
+#include <utils/types.h>
+#include <utils/span.h>
+
+namespace tayir {
+    /**
+     * @brief 紧凑指令
+     * 
+     * @see Ins
+     * 
+     * 8字节编码:
+     * 
+     * | 位      | 内容     |
+     * |---------|----------|
+     * | 0 ~ 7   | 指令类型 |
+     * | 8 ~ 25  | 目的数   |
+     * | 26 ~ 43 | 操作数1  |
+     * | 44 ~ 61 | 操作数2  |
+     * | 62      | 操作数2为调用参数段 |
+     * 
+     * 每个18位操作数字段中, 最高位为1时低17位为有符号立即数,
+     * 否则低17位为操作数池ID, 0x1FFFF表示空
+     * 第62位为1时, 操作数2字段为调用参数段的偏移(高10位)与数量(低8位)
+     * 
+     */
+    class PackedIns {
+    protected:
+        /** 编码 */
+        qword bits;
+        /** 操作数字段宽度 */
+        static const int FIELD_BITS = 18;
+        /** 操作数字段掩码 */
+        static const qword FIELD_MASK = (1ull << FIELD_BITS) - 1;
+        /** 立即数标记 */
+        static const qword FIELD_IMM_TAG = 1ull << (FIELD_BITS - 1);
+        /** 空操作数 */
+        static const qword FIELD_EMPTY = FIELD_IMM_TAG - 1;
+        /** 字段可容纳的最小立即数 */
+        static const int FIELD_IMM_MIN = -(1 << (FIELD_BITS - 2));
+        /** 字段可容纳的最大立即数 */
+        static const int FIELD_IMM_MAX = (1 << (FIELD_BITS - 2)) - 1;
+        /** 操作数2为调用参数段 */
+        static const qword ARG_SPAN_FLAG = 1ull << 62;
+        /** 字段可容纳的调用参数段最大偏移 */
+        static const int FIELD_ARG_SPAN_MAX_OFFSET = (1 << (FIELD_BITS - 8)) - 1;
+        /**
+         * @brief 编码操作数
+         * 
+         * @param op 操作数
+         * @return 字段
+         */
+        static qword PackOp(int op);
+        /**
+         * @brief 解码操作数
+         * 
+         * @param field 字段
+         * @return 操作数
+         */
+        static int UnpackOp(qword field);
+        /**
+         * @brief 获取字段
+         * 
+         * @param sub 字段下标(0为目的数)
+         * @return 字段
+         */
+        qword GetField(int sub) const {
+            return (bits >> (8 + sub * FIELD_BITS)) & FIELD_MASK;
+        }
+    public:
+        /**
+         * @brief PackedIns构造函数
+         * 
+         * 构造NOP指令
+         * 
+         */
+        PackedIns();
+        /**
+         * @brief PackedIns构造函数
+         * 
+         * @param ins 指令(须满足CanPack)
+         */
+        PackedIns(const Ins &ins);
+        /**
+         * @brief 操作数能否编码
+         * 
+         * @param op 操作数
+         * @return 能否编码
+         */
+        static const bool CanPackOp(int op);
+        /**
+         * @brief 指令能否编码
+         * 
+         * @param ins 指令
+         * @return 能否编码
+         */
+        static const bool CanPack(const Ins &ins);
+        /**
+         * @brief 获取指令类型
+         * 
+         * @return 指令类型
+         */
+        const InsType GetInsType() const {
+            return (InsType)(bits & 0xFF);
+        }
+        /**
+         * @brief 获取目的数
+         * 
+         * @return 目的数
+         */
+        const int GetDestOp() const {
+            return UnpackOp(GetField(0));
+        }
+        /**
+         * @brief 获取操作数1
+         * 
+         * @return 操作数1
+         */
+        const int GetSrc1Op() const {
+            return UnpackOp(GetField(1));
+        }
+        /**
+         * @brief 获取操作数2
+         * 
+         * @return 操作数2
+         */
+        const int GetSrc2Op() const {
+            if ((bits & ARG_SPAN_FLAG) != 0) {
+                return MakeArgSpan(GetField(2) >> 8, GetField(2) & 0xFF);
+            }
+            return UnpackOp(GetField(2));
+        }
+        /**
+         * @brief 解码为指令
+         * 
+         * @return 指令
+         */
+        const Ins Unpack() const;
+    };
+
+    /**
+     * @brief 紧凑IR片段
+     * 
+     * @see IRFragment
+     * 
+     * 以PackedIns存储指令, 占用内存为IRFragment的一半
+     * 
+     */
+    class IRPackedFragment : public IRSlice {
+    protected:
+        /** 指令数 */
+        const int insNum;
+        /** 指令数组 */
+        PackedIns *instructions;
+    public:
+        /**
+         * @brief IRPackedFragment构造函数
+         * 
+         * @param slice 源切片(须满足CanPack)
+         */
+        IRPackedFragment(const IRSlice &slice);
+        /**
+         * @brief IRPackedFragment析构函数
+         * 
+         */
+        virtual ~IRPackedFragment();
+        /**
+         * @brief 切片能否编码
+         * 
+         * @param slice 切片
+         * @return 能否编码
+         */
+        static const bool CanPack(const IRSlice &slice);
+        /**
+         * @brief 获取指令数量
+         * 
+         * @return 指令数量
+         */
+        virtual const int GetInsNum() const override;
+        /**
+         * @brief 获取指令
+         * 
+         * @param sub 下标
+         * @return 指令
+         */
+        virtual const Ins GetIns(int sub) const override;
+        /**
+         * @brief 获取紧凑指令数组
+         * 
+         * @return 紧凑指令数组
+         */
+        Span<const PackedIns> GetPackedIns() const {
+            return Span<const PackedIns>(instructions, insNum);
+        }
+        /**
+         * @brief 获取指令占用字节数
+         * 
+         * @return 字节数
+         */
+        const size_t GetByteSize() const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,857 @@
+/**
+ * @file parser.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 文本IR解析器
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/parser.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tayir {
+    /**
+     * @brief 是否为标识符字符
+     * 
+     * @param ch 字符
+     * @return 是否为标识符字符
+     */
+    static inline bool IsIdentChar(char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9')
+            || ch == '_' || ch == '$' || ch == '.';
+    }
+
+    /**
+     * @brief 找到标识符结尾
+     * 
+     * @param p 起点
+     * @param end 输入结尾
+     * @return 第一个非标识符字符
+     */
+    static const char *ScanIdentEnd(const char *p, const char *end) {
+#if defined(__SSE2__)
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        while (end - p >= 16) {
+            const __m128i chars = _mm_loadu_si128((const __m128i *)p);
+            // 字母统一转为小写后判断范围; 0x80以上的字节为负数, 不落入任何范围
+            const __m128i lower = _mm_or_si128(chars, caseBit);
+            const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+            const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+            const __m128i extra = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('_')),
+                _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('$')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('.'))));
+            const int stops = ~_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(alpha, digit), extra)) & 0xFFFF;
+            if (stops != 0) {
+                return p + __builtin_ctz(stops);
+            }
+            p += 16;
+        }
+#endif
+        while (p < end && IsIdentChar(*p)) {
+            p ++;
+        }
+        return p;
+    }
+
+    /**
+     * @brief 跳过空白(不超过0x20的字节)
+     * 
+     * @param p 起点
+     * @param end 输入结尾
+     * @return 第一个非空白字符
+     */
+    static const char *SkipBlank(const char *p, const char *end) {
+        // 大多数间隔只有一个空格
+        if (p < end && (unsigned char)*p > ' ') {
+            return p;
+        }
+#if defined(__SSE2__)
+        const __m128i printable = _mm_set1_epi8(' ' + 1);
+        while (end - p >= 16) {
+            const __m128i chars = _mm_loadu_si128((const __m128i *)p);
+            const int stops = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chars, printable), chars));
+            if (stops != 0) {
+                return p + __builtin_ctz(stops);
+            }
+            p += 16;
+        }
+#endif
+        while (p < end && (unsigned char)*p <= ' ') {
+            p ++;
+        }
+        return p;
+    }
+
+    /**
+     * @brief 将至多8字节的助记符打包为整数
+     * 
+     * @param str 助记符
+     * @return 打包结果(过长时为0)
+     */
+    static qword PackMnemonic(std::string_view str) {
+        qword key = 0;
+        if (str.size() > sizeof(key)) {
+            return 0;
+        }
+        memcpy(&key, str.data(), str.size());
+        return key;
+    }
+
+    /**
+     * @brief 查找指令类型
+     * 
+     * @param str 助记符
+     * @return 指令类型(不存在时为-1)
+     */
+    static int FindInsType(std::string_view str) {
+        // 局部静态变量的初始化是线程安全的
+        static const std::vector<qword> keys = [] {
+            std::vector<qword> keys((int)InsType::INV + 1);
+            for (int i = 0 ; i <= (int)InsType::INV ; i ++) {
+                keys[i] = PackMnemonic(ToString((InsType)i));
+            }
+            return keys;
+        }();
+        const qword key = PackMnemonic(str);
+        for (int i = 0 ; i <= (int)InsType::INV ; i ++) {
+            if (keys[i] == key && key != 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief 找到下一个括号, 注释或字符字面量的开头
+     * 
+     * @param p 起点
+     * @param end 输入结尾
+     * @return 第一个'{', '}', '/'或'\''
+     */
+    static const char *ScanBraces(const char *p, const char *end) {
+#if defined(__SSE2__)
+        while (end - p >= 16) {
+            const __m128i chars = _mm_loadu_si128((const __m128i *)p);
+            const __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('{')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\''))));
+            const int stops = _mm_movemask_epi8(hits);
+            if (stops != 0) {
+                return p + __builtin_ctz(stops);
+            }
+            p += 16;
+        }
+#endif
+        while (p < end && *p != '{' && *p != '}' && *p != '/' && *p != '\'') {
+            p ++;
+        }
+        return p;
+    }
+
+    /**
+     * @brief IRParser构造函数
+     * 
+     * @param module 模块
+     */
+    IRParser::IRParser(IRModule &module)
+        : module(&module), pool(module.GetOperandPool()), man(module.GetTypeManager()),
+          begin(NULL), pos(NULL), end(NULL), errorPos(NULL), errorLine(0)
+    {
+    }
+
+    /**
+     * @brief IRParser构造函数
+     * 
+     * 分段解析用, 函数不加入模块
+     * 
+     * @param pool 操作数池
+     * @param man 类型管理器
+     */
+    IRParser::IRParser(OperandPool &pool, TypeManager &man)
+        : module(NULL), pool(pool), man(man),
+          begin(NULL), pos(NULL), end(NULL), errorPos(NULL), errorLine(0)
+    {
+    }
+
+    /**
+     * @brief 报告语法错误
+     * 
+     * @param msg 错误信息
+     */
+    void IRParser::Error(const char *msg) {
+        errorPos = pos < end ? pos : end;
+        errorLine = 1 + std::count(begin, errorPos, '\n');
+        //TODO: throw an exception instead of const char *
+        throw msg;
+    }
+
+    /**
+     * @brief 跳过空白与注释(包括换行)
+     * 
+     */
+    void IRParser::SkipSpace() {
+        while (true) {
+            pos = SkipBlank(pos, end);
+            if (end - pos < 2 || pos[0] != '/') {
+                return;
+            }
+            if (pos[1] == '/') {
+                const char *newline = (const char *)memchr(pos, '\n', end - pos);
+                pos = newline != NULL ? newline : end;
+            }
+            else if (pos[1] == '*') {
+                const char *p = pos + 2;
+                while (true) {
+                    p = (const char *)memchr(p, '*', end - p);
+                    if (p == NULL || p + 1 >= end) {
+                        Error("Unterminated comment!");
+                    }
+                    if (p[1] == '/') {
+                        break;
+                    }
+                    p ++;
+                }
+                pos = p + 2;
+            }
+            else {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief 跳过行内空白与注释
+     * 
+     * @return 是否到达行尾
+     */
+    bool IRParser::SkipInlineSpace() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+            pos ++;
+        }
+        if (pos >= end || *pos == '\n' || *pos == '}') {
+            return true;
+        }
+        if (end - pos >= 2 && pos[0] == '/' && pos[1] == '/') {
+            return true;
+        }
+        if (end - pos >= 2 && pos[0] == '/' && pos[1] == '*') {
+            // 跨行注释视为行尾
+            const char *start = pos;
+            SkipSpace();
+            return memchr(start, '\n', pos - start) != NULL || SkipInlineSpace();
+        }
+        return false;
+    }
+
+    /**
+     * @brief 读标识符
+     * 
+     * @return 标识符(引用输入, 可能为空)
+     */
+    std::string_view IRParser::ScanIdent() {
+        const char *start = pos;
+        pos = ScanIdentEnd(pos, end);
+        return std::string_view(start, pos - start);
+    }
+
+    /**
+     * @brief 读必需的标识符
+     * 
+     * @return 标识符(引用输入)
+     */
+    std::string_view IRParser::ExpectIdent() {
+        std::string_view ident = ScanIdent();
+        if (ident.empty()) {
+            Error("Expected identifier!");
+        }
+        return ident;
+    }
+
+    /**
+     * @brief 接受字符
+     * 
+     * @param ch 字符
+     * @return 是否接受
+     */
+    bool IRParser::Accept(char ch) {
+        SkipSpace();
+        if (pos < end && *pos == ch) {
+            pos ++;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 要求字符
+     * 
+     * @param ch 字符
+     */
+    void IRParser::Expect(char ch) {
+        if (! Accept(ch)) {
+            Error("Unexpected character!");
+        }
+    }
+
+    /**
+     * @brief 解析类型
+     * 
+     * @return 类型ID
+     */
+    int IRParser::ParseType() {
+        SkipSpace();
+        const std::string_view name = ExpectIdent();
+        for (const auto &entry : typeCache) {
+            if (entry.first == name) {
+                return entry.second;
+            }
+        }
+        const int typeId = man.GetTypeId(std::string(name));
+        if (typeId == -1) {
+            Error("Unknown type!");
+        }
+        typeCache.push_back(std::make_pair(std::string(name), typeId));
+        return typeId;
+    }
+
+    /**
+     * @brief 解析参数表
+     * 
+     * 左括号已读入, 读到右括号为止
+     * 
+     * @param args 参数表
+     */
+    void IRParser::ParseArgs(std::vector<Argument> &args) {
+        if (Accept(')')) {
+            return;
+        }
+        do {
+            const int typeId = ParseType();
+            Expect('%');
+            args.push_back(Argument(typeId, ExpectIdent()));
+        } while (Accept(','));
+        Expect(')');
+    }
+
+    /**
+     * @brief 解析数值立即数
+     * 
+     * 整数能内联时内联, 否则为i32或i64; 带小数点或指数的为double, 带f后缀的为float; 0x开头的为指针
+     * 
+     * @return 操作数
+     */
+    int IRParser::ParseNumber() {
+        const char *start = pos;
+        const char *p = *pos == '-' ? pos + 1 : pos;
+        while (p < end && *p >= '0' && *p <= '9') {
+            p ++;
+        }
+        ImmediateValue value;
+        value.ui64Val = 0;
+        if (p == start + 1 && *start == '0' && p < end && *p == 'x') {
+            // 非空指针按十六进制打印
+            const std::from_chars_result result = std::from_chars(p + 1, end, value.ui64Val, 16);
+            if (result.ec != std::errc()) {
+                Error("Bad number!");
+            }
+            pos = result.ptr;
+            return pool.GetOrAddImmediate(imm::itype::P64, value);
+        }
+        if (p < end && (*p == '.' || *p == 'e' || *p == 'E' || *p == 'f')) {
+            double real;
+            const std::from_chars_result result = std::from_chars(start, end, real);
+            if (result.ec != std::errc()) {
+                Error("Bad number!");
+            }
+            pos = result.ptr;
+            if (pos < end && *pos == 'f') {
+                pos ++;
+                value.floatVal = (float)real;
+                return pool.GetOrAddImmediate(imm::itype::FLOAT, value);
+            }
+            value.doubleVal = real;
+            return pool.GetOrAddImmediate(imm::itype::DOUBLE, value);
+        }
+        long long integer;
+        const std::from_chars_result result = std::from_chars(start, p, integer);
+        if (result.ec != std::errc() || result.ptr != p) {
+            Error("Bad number!");
+        }
+        pos = p;
+        if (FitsInlineImm(integer)) {
+            return MakeInlineImm((int)integer);
+        }
+        if (integer >= -0x80000000ll && integer <= 0x7FFFFFFFll) {
+            return pool.GetOrAddInt((int)integer);
+        }
+        value.i64Val = integer;
+        return pool.GetOrAddImmediate(imm::itype::I64, value);
+    }
+
+    /**
+     * @brief 解析操作数
+     * 
+     * @param fnBuilder 函数构造器(用于调用参数)
+     * @param allowArgs 是否允许调用参数表
+     * @return 操作数
+     */
+    int IRParser::ParseOperand(IRFunctionBuilder &fnBuilder, bool allowArgs) {
+        SkipSpace();
+        if (pos >= end) {
+            Error("Expected operand!");
+        }
+        const char ch = *pos;
+        if (ch == '%' || ch == '@' || ch == '#') {
+            pos ++;
+            const SymbolScope scope = ch == '%' ? SymbolScope::LOCAL : (ch == '@' ? SymbolScope::GLOBAL : SymbolScope::BUILTIN);
+            return pool.GetOrAddSymbol(scope, ExpectIdent());
+        }
+        if (ch == '-' || (ch >= '0' && ch <= '9')) {
+            return ParseNumber();
+        }
+        if (ch == '\'') {
+            if (end - pos < 3 || pos[2] != '\'') {
+                Error("Bad character literal!");
+            }
+            ImmediateValue value;
+            value.ui64Val = 0;
+            value.i8Val = pos[1];
+            pos += 3;
+            return pool.GetOrAddImmediate(imm::itype::I8, value);
+        }
+        if (ch == '[') {
+            // 参数表只能是call的第二个操作数, 不能嵌套
+            if (! allowArgs) {
+                Error("Unexpected call arguments!");
+            }
+            pos ++;
+            argScratch.clear();
+            if (! Accept(']')) {
+                do {
+                    const int arg = ParseOperand(fnBuilder, false);
+                    argScratch.push_back(arg);
+                } while (Accept(','));
+                Expect(']');
+            }
+            return fnBuilder.AppendCallArgs(argScratch);
+        }
+        const std::string_view ident = ExpectIdent();
+        ImmediateValue value;
+        value.ui64Val = 0;
+        if (ident == "true" || ident == "false") {
+            value.boolVal = ident == "true";
+            return pool.GetOrAddImmediate(imm::itype::BOOL, value);
+        }
+        if (ident == "null") {
+            return pool.GetOrAddImmediate(imm::itype::P64, value);
+        }
+        return pool.GetOrAddLabel(ident);
+    }
+
+    /**
+     * @brief 解析指令
+     * 
+     * 指令占一行: [%dest =] 助记符 [操作数 {, 操作数}]
+     * br的第一个操作数为条件, 存放在目的数位置
+     * 
+     * @param fnBuilder 函数构造器
+     * @param blockBuilder 基本块构造器
+     */
+    void IRParser::ParseIns(IRFunctionBuilder &fnBuilder, IRBasicBlockBuilder &blockBuilder) {
+        int ops[3] = {-1, -1, -1};
+        if (Accept('%')) {
+            ops[0] = pool.GetOrAddSymbol(SymbolScope::LOCAL, ExpectIdent());
+            Expect('=');
+            SkipSpace();
+        }
+        const int insType = FindInsType(ScanIdent());
+        if (insType == -1) {
+            Error("Unknown instruction!");
+        }
+        const bool isBr = insType == (int)InsType::BR;
+        if (isBr && ops[0] != -1) {
+            Error("br has no result!");
+        }
+        int sub = isBr ? 0 : 1;
+        if (! SkipInlineSpace()) {
+            do {
+                if (sub > 2) {
+                    Error("Too many operands!");
+                }
+                ops[sub] = ParseOperand(fnBuilder, insType == (int)InsType::CALL && sub == 2);
+                sub ++;
+            } while (Accept(','));
+        }
+        blockBuilder.AppendIns(Ins((InsType)insType, ops[0], ops[1], ops[2]));
+    }
+
+    /**
+     * @brief 解析函数定义
+     * 
+     * "def"已读入
+     * 
+     * @return 函数
+     */
+    IRFunction *IRParser::ParseFunction() {
+        IRFunctionBuilder fnBuilder;
+        IRFuncDecl &decl = fnBuilder.GetDecl();
+        decl.conventionId = 0;
+        decl.returnTypeId = -1;
+        Expect('@');
+        decl.name = ExpectIdent();
+        Expect('(');
+        ParseArgs(decl.args);
+        if (Accept('-')) {
+            Expect('>');
+            decl.returnTypeId = ParseType();
+        }
+        Expect('{');
+
+        IRBasicBlockBuilder blockBuilder;
+        Name blockName;
+        bool inBlock = false;
+        while (! Accept('}')) {
+            if (pos >= end) {
+                Error("Unterminated function!");
+            }
+            // 标号: 标识符后跟':'或'('
+            if (*pos != '%') {
+                const char *start = pos;
+                const std::string_view ident = ScanIdent();
+                SkipSpace();
+                if (! ident.empty() && pos < end && (*pos == ':' || *pos == '(')) {
+                    if (inBlock) {
+                        fnBuilder.AppendBlock(blockBuilder.Build(blockName));
+                    }
+                    blockName = ident;
+                    inBlock = true;
+                    if (Accept('(')) {
+                        std::vector<Argument> args;
+                        ParseArgs(args);
+                        for (const Argument &arg : args) {
+                            blockBuilder.AppendArg(arg);
+                        }
+                    }
+                    Expect(':');
+                    continue;
+                }
+                pos = start;
+            }
+            if (! inBlock) {
+                Error("Expected block label!");
+            }
+            ParseIns(fnBuilder, blockBuilder);
+        }
+        if (inBlock) {
+            fnBuilder.AppendBlock(blockBuilder.Build(blockName));
+        }
+
+        IRFunction *func = NULL;
+        if (fnBuilder.TryBuild(pool, func) != IRStatus::OK) {
+            Error("Bad function body!");
+        }
+        return func;
+    }
+
+    /**
+     * @brief 跳过函数定义(只匹配括号)
+     * 
+     * "def"已读入, 跳过注释与字符字面量中的括号
+     * 
+     */
+    void IRParser::SkipFunction() {
+        int depth = 0;
+        while (true) {
+            pos = ScanBraces(pos, end);
+            if (pos >= end) {
+                Error("Unterminated function!");
+            }
+            switch (*pos) {
+            case '{':
+                depth ++;
+                pos ++;
+                break;
+            case '}':
+                pos ++;
+                if (-- depth <= 0) {
+                    return;
+                }
+                break;
+            case '/':
+                if (end - pos >= 2 && (pos[1] == '/' || pos[1] == '*')) {
+                    SkipSpace();
+                }
+                else {
+                    pos ++;
+                }
+                break;
+            default:
+                pos = end - pos >= 3 ? pos + 3 : end;
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief 扫描顶层定义
+     * 
+     * 处理import, 记录每个函数定义在"def"之后的位置与括号匹配得到的结尾
+     * 扫描失败时不抛出, 返回失败的顶层项的位置, 由串行解析从该处继续并报告错误
+     * 
+     * @param items 函数定义位置
+     * @param itemEnds 函数定义结尾('}'之后)
+     * @return 需要串行解析的位置(全部扫描完时为NULL)
+     */
+    const char *IRParser::ScanItems(std::vector<const char *> &items, std::vector<const char *> &itemEnds) {
+        const char *itemStart = pos;
+        try {
+            while (true) {
+                itemStart = pos;
+                SkipSpace();
+                if (pos >= end) {
+                    break;
+                }
+                const std::string_view keyword = ScanIdent();
+                if (keyword == "def") {
+                    const char *item = pos;
+                    SkipFunction();
+                    items.push_back(item);
+                    itemEnds.push_back(pos);
+                }
+                else if (keyword == "import") {
+                    // 导入由链接阶段处理, 这里只跳过模块名
+                    SkipSpace();
+                    ExpectIdent();
+                }
+                else {
+                    Error("Expected definition!");
+                }
+            }
+        }
+        catch (const char *) {
+            errorPos = NULL;
+            errorLine = 0;
+            return itemStart;
+        }
+        return NULL;
+    }
+
+    /**
+     * @brief 串行解析顶层定义直到输入结尾
+     * 
+     */
+    void IRParser::ParseItems() {
+        while (true) {
+            SkipSpace();
+            if (pos >= end) {
+                break;
+            }
+            const char *start = pos;
+            const std::string_view keyword = ScanIdent();
+            if (keyword == "def") {
+                IRFunction *func = ParseFunction();
+                if (module->AppendFunction(func) == -1) {
+                    delete func;
+                    pos = start;
+                    Error("Duplicate function!");
+                }
+            }
+            else if (keyword == "import") {
+                // 导入由链接阶段处理, 这里只跳过模块名
+                SkipSpace();
+                ExpectIdent();
+            }
+            else {
+                Error("Expected definition!");
+            }
+        }
+    }
+
+    /**
+     * @brief 解析文本
+     * 
+     * 出错时抛出错误信息, 行号由GetErrorLine获取
+     * 
+     * @param text 文本(不要求以0结尾)
+     * @param length 字节数
+     */
+    void IRParser::Parse(const char *text, size_t length) {
+        begin = pos = text;
+        end = text + length;
+        errorPos = NULL;
+        errorLine = 0;
+        ParseItems();
+    }
+
+    /**
+     * @brief 并行解析文本
+     * 
+     * 结果(模块, 操作数池与错误)与串行解析相同:
+     * 合并到第一个解析失败或边界与括号扫描不一致的函数为止, 其余部分串行解析
+     * 线程池只有一个线程或函数少于PARSE_PARALLEL_MIN_FUNCS时串行解析
+     * 
+     * @param text 文本(不要求以0结尾)
+     * @param length 字节数
+     * @param threads 线程池
+     */
+    void IRParser::ParseParallel(const char *text, size_t length, ThreadPool &threads) {
+        if (threads.GetThreadNum() == 1) {
+            Parse(text, length);
+            return;
+        }
+        begin = pos = text;
+        end = text + length;
+        errorPos = NULL;
+        errorLine = 0;
+        std::vector<const char *> items;
+        std::vector<const char *> itemEnds;
+        const char *serialFrom = ScanItems(items, itemEnds);
+        const int itemNum = items.size();
+        if (itemNum < PARSE_PARALLEL_MIN_FUNCS) {
+            // 扫描没有副作用, 从头串行解析
+            pos = begin;
+            ParseItems();
+            return;
+        }
+
+        // 按字节数把连续的函数分段, 段数多于线程数以平衡负载
+        const int taskNum = std::min(itemNum, threads.GetThreadNum() * 8);
+        std::vector<int> taskBegin(taskNum + 1, itemNum);
+        taskBegin[0] = 0;
+        for (int i = 0, task = 1 ; i < itemNum && task < taskNum ; i ++) {
+            if ((size_t)(items[i] - items[0]) * taskNum >= (size_t)(itemEnds.back() - items[0]) * task) {
+                taskBegin[task ++] = i;
+            }
+        }
+
+        // 各段解析到自己的操作数池; 类型只读, 名称驻留表线程安全
+        // poolMarks[i]为解析完第i个函数后局部操作数池的大小, 局部ID按首次使用的顺序分配
+        std::vector<IRFunction *> funcs(itemNum, (IRFunction *)NULL);
+        std::vector<int> poolMarks(itemNum, 0);
+        std::vector<std::unique_ptr<OperandPool>> localPools(taskNum);
+        std::vector<int> taskStop(taskBegin.begin() + 1, taskBegin.end());
+        threads.Run(taskNum, [&](int task) {
+            localPools[task].reset(new OperandPool(pool.GetMode()));
+            IRParser worker(*localPools[task], man);
+            worker.begin = begin;
+            worker.end = end;
+            for (int i = taskBegin[task] ; i < taskBegin[task + 1] ; i ++) {
+                worker.pos = items[i];
+                try {
+                    funcs[i] = worker.ParseFunction();
+                }
+                catch (const char *) {
+                    taskStop[task] = i;
+                    return;
+                }
+                poolMarks[i] = localPools[task]->GetOperandNum();
+                if (worker.pos != itemEnds[i]) {
+                    taskStop[task] = i;
+                    return;
+                }
+            }
+        });
+
+        // 按文件顺序合并, 操作数ID与串行解析一致
+        int stop = itemNum;
+        std::vector<int> remap;
+        for (int task = 0 ; task < taskNum && stop == itemNum ; task ++) {
+            const int first = taskBegin[task];
+            OperandPool &localPool = *localPools[task];
+            remap.resize(taskStop[task] > first ? poolMarks[taskStop[task] - 1] : 0);
+            for (int id = 0 ; id < (int)remap.size() ; id ++) {
+                remap[id] = pool.Import(localPool, id);
+            }
+            for (int i = first ; i < taskStop[task] ; i ++) {
+                funcs[i]->RemapOperands(Span<const int>(remap.data(), remap.size()));
+                if (module->AppendFunction(funcs[i]) == -1) {
+                    stop = i;
+                    break;
+                }
+                funcs[i] = NULL;
+            }
+            if (taskStop[task] < taskBegin[task + 1]) {
+                stop = std::min(stop, taskStop[task]);
+            }
+        }
+        for (IRFunction *func : funcs) {
+            delete func;
+        }
+        localPools.clear();
+
+        // 出错的函数及扫描失败之后的部分串行解析, 由此报告与串行解析相同的错误
+        pos = stop < itemNum ? items[stop] - 3 : serialFrom;
+        if (pos != NULL) {
+            ParseItems();
+        }
+    }
+
+    /**
+     * @brief 解析文件
+     * 
+     * 文件被映射到内存后直接解析
+     * 
+     * @param path 文件路径
+     * @param threads 线程池(为NULL时串行解析)
+     */
+    void IRParser::ParseFile(const char *path, ThreadPool *threads) {
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't open file!";
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            //TODO: throw an exception instead of const char *
+            throw "Can't read file!";
+        }
+        if (info.st_size == 0) {
+            close(fd);
+            return;
+        }
+        void *mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            //TODO: throw an exception instead of const char *
+            throw "Can't map file!";
+        }
+        madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+        try {
+            if (threads != NULL) {
+                ParseParallel((const char *)mapped, info.st_size, *threads);
+            }
+            else {
+                Parse((const char *)mapped, info.st_size);
+            }
+        }
+        catch (...) {
+            munmap(mapped, info.st_size);
+            throw;
+        }
+        munmap(mapped, info.st_size);
+    }
+
+    /**
+     * @brief 获取出错行号
+     * 
+     * @return 行号(从1开始, 没有出错时为0)
+     */
+    const int IRParser::GetErrorLine() const {
+        return errorLine;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/**
+ * @file parser.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 文本IR解析器
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/module.h>
+#include <utils/threadpool.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tayir {
+    /** 并行解析的最少函数数, 更少时预扫描与合并的开销超过收益, 直接串行解析 */
+    static const int PARSE_PARALLEL_MIN_FUNCS = 256;
+
+    /**
+     * @brief 文本IR(.ir)解析器
+     * 
+     * 解析PrintRawString输出的文本格式:
+     * 
+     * ```
+     * import std
+     * def @fib(i32 %n) -> i32 {
+     * start:
+     *     %c = equ %n, 0
+     *     br %c, if0, else0
+     * ...
+     * }
+     * ```
+     * 
+     * 词法分析直接在输入上进行, 名称以string_view引用输入, 只在驻留新名称时复制
+     * 支持SSE2时空白与标识符一次扫描16字节
+     * 操作数写入模块的操作数池, 函数写入模块
+     * 
+     * 并行解析时先扫描出每个函数的边界, 再由线程池分段解析到各自的操作数池,
+     * 最后按文件顺序合并, 结果与串行解析完全相同
+     * 
+     */
+    class IRParser {
+    protected:
+        /** 模块(分段解析时为NULL) */
+        IRModule *module;
+        /** 操作数池 */
+        OperandPool &pool;
+        /** 类型管理器 */
+        TypeManager &man;
+        /** 输入开头 */
+        const char *begin;
+        /** 当前位置 */
+        const char *pos;
+        /** 输入结尾 */
+        const char *end;
+        /** 出错位置 */
+        const char *errorPos;
+        /** 出错行号 */
+        int errorLine;
+        /** 调用参数暂存 */
+        std::vector<int> argScratch;
+        /** 类型名 -> 类型ID缓存 */
+        std::vector<std::pair<std::string, int>> typeCache;
+        /**
+         * @brief 报告语法错误
+         * 
+         * @param msg 错误信息
+         */
+        [[noreturn]] void Error(const char *msg);
+        /**
+         * @brief 跳过空白与注释(包括换行)
+         * 
+         */
+        void SkipSpace();
+        /**
+         * @brief 跳过行内空白与注释
+         * 
+         * @return 是否到达行尾
+         */
+        bool SkipInlineSpace();
+        /**
+         * @brief 读标识符
+         * 
+         * @return 标识符(引用输入, 可能为空)
+         */
+        std::string_view ScanIdent();
+        /**
+         * @brief 读必需的标识符
+         * 
+         * @return 标识符(引用输入)
+         */
+        std::string_view ExpectIdent();
+        /**
+         * @brief 接受字符
+         * 
+         * @param ch 字符
+         * @return 是否接受
+         */
+        bool Accept(char ch);
+        /**
+         * @brief 要求字符
+         * 
+         * @param ch 字符
+         */
+        void Expect(char ch);
+        /**
+         * @brief 解析类型
+         * 
+         * @return 类型ID
+         */
+        int ParseType();
+        /**
+         * @brief 解析参数表
+         * 
+         * @param args 参数表
+         */
+        void ParseArgs(std::vector<Argument> &args);
+        /**
+         * @brief 解析数值立即数
+         * 
+         * @return 操作数
+         */
+        int ParseNumber();
+        /**
+         * @brief 解析操作数
+         * 
+         * @param fnBuilder 函数构造器(用于调用参数)
+         * @param allowArgs 是否允许调用参数表
+         * @return 操作数
+         */
+        int ParseOperand(IRFunctionBuilder &fnBuilder, bool allowArgs);
+        /**
+         * @brief 解析指令
+         * 
+         * @param fnBuilder 函数构造器
+         * @param blockBuilder 基本块构造器
+         */
+        void ParseIns(IRFunctionBuilder &fnBuilder, IRBasicBlockBuilder &blockBuilder);
+        /**
+         * @brief 解析函数定义
+         * 
+         * @return 函数
+         */
+        IRFunction *ParseFunction();
+        /**
+         * @brief 跳过函数定义(只匹配括号)
+         * 
+         */
+        void SkipFunction();
+        /**
+         * @brief 扫描顶层定义
+         * 
+         * 处理import, 记录每个函数定义在"def"之后的位置与括号匹配得到的结尾
+         * 扫描失败时不抛出, 返回失败的顶层项的位置, 由串行解析从该处继续并报告错误
+         * 
+         * @param items 函数定义位置
+         * @param itemEnds 函数定义结尾('}'之后)
+         * @return 需要串行解析的位置(全部扫描完时为NULL)
+         */
+        const char *ScanItems(std::vector<const char *> &items, std::vector<const char *> &itemEnds);
+        /**
+         * @brief 串行解析顶层定义直到输入结尾
+         * 
+         */
+        void ParseItems();
+        /**
+         * @brief IRParser构造函数
+         * 
+         * 分段解析用, 函数不加入模块
+         * 
+         * @param pool 操作数池
+         * @param man 类型管理器
+         */
+        IRParser(OperandPool &pool, TypeManager &man);
+    public:
+        /**
+         * @brief IRParser构造函数
+         * 
+         * @param module 模块
+         */
+        IRParser(IRModule &module);
+        /**
+         * @brief 解析文本
+         * 
+         * 出错时抛出错误信息, 行号由GetErrorLine获取
+         * 
+         * @param text 文本(不要求以0结尾)
+         * @param length 字节数
+         */
+        void Parse(const char *text, size_t length);
+        /**
+         * @brief 并行解析文本
+         * 
+         * 结果(模块, 操作数池与错误)与串行解析相同
+         * 线程池只有一个线程或函数少于PARSE_PARALLEL_MIN_FUNCS时串行解析
+         * 
+         * @param text 文本(不要求以0结尾)
+         * @param length 字节数
+         * @param threads 线程池
+         */
+        void ParseParallel(const char *text, size_t length, ThreadPool &threads);
+        /**
+         * @brief 解析文件
+         * 
+         * 文件被映射到内存后直接解析
+         * 
+         * @param path 文件路径
+         * @param threads 线程池(为NULL时串行解析)
+         */
+        void ParseFile(const char *path, ThreadPool *threads = NULL);
+        /**
+         * @brief 获取出错行号
+         * 
+         * @return 行号(从1开始, 没有出错时为0)
+         */
+        const int GetErrorLine() const;
+    };
+}
\ No newline at end of file
@@ -11,8 +11,28 @@
  */
 
 #include <ir/slice.h>
+#include <utils/check.h>
+
+#include <algorithm>
 
 namespace tayir {
+    /**
+     * @brief 向调用参数流追加参数段
+     * 
+     * @param stream 调用参数流
+     * @param args 参数
+     * @return 调用参数段
+     */
+    static int AppendArgSpan(std::vector<int> &stream, const std::vector<int> &args) {
+        if ((int)args.size() > ARG_SPAN_MAX_COUNT || (int)stream.size() > ARG_SPAN_MAX_OFFSET) {
+            //TODO: throw an exception instead of const char *
+            throw "Too many call arguments!";
+        }
+        int argSpan = MakeArgSpan(stream.size(), args.size());
+        stream.insert(stream.end(), args.begin(), args.end());
+        return argSpan;
+    }
+
 //---------------------------------------------------------
 //|                                                       |
 //|                      ir fragment                      |
@@ -22,14 +42,13 @@ namespace tayir {
     /**
      * @brief IRFragment构造函数
      * 
+     * 直接接管指令列表的存储, 不复制指令
+     * 
      * @param insList 指令列表
      */
-    IRFragment::IRFragment(std::vector<Ins> insList) 
-        : insNum(insList.size()), instructions(new Ins[insNum])
+    IRFragment::IRFragment(std::vector<Ins> &&insList) 
+        : insNum(insList.size()), instructions(std::move(insList))
     {
-        for (int i = 0 ; i < insNum ; i ++) {
-            instructions[i] = insList.at(i);
-        }
     }
 
     /**
@@ -37,10 +56,6 @@ namespace tayir {
      * 
      */
     IRFragment::~IRFragment() {
-        if (instructions != NULL) {
-            delete[] instructions;
-            instructions = NULL;
-        }
     }
 
     /**
@@ -59,23 +74,35 @@ namespace tayir {
      * @return 指令
      */
     const Ins IRFragment::GetIns(int sub) const {
-        if (sub < 0 || sub >= insNum) {
+        if (TAYIR_OUT_OF_BOUND(sub, insNum)) {
             //TODO: throw an exception instead of const char *
             throw "Out of boundary!";
         }
         return instructions[sub];
     }
 
+    /**
+     * @brief 获取指令表占用字节数
+     * 
+     * 按容量计算
+     * 
+     * @return 字节数
+     */
+    const size_t IRFragment::GetInsReservedBytes() const {
+        return sizeof(Ins) * instructions.capacity();
+    }
+
     /**
      * @brief 打印
      * 
      * @param pool 操作数池
      * @param outs 输出流 
+     * @param callArgs 所在函数的调用参数流
      */
-    void IRFragment::PrintRawString(OperandPool &pool, std::ostream &outs) const {
+    void IRFragment::PrintRawString(OperandPool &pool, std::ostream &outs, Span<const int> callArgs) const {
         for (int i = 0 ; i < insNum ; i ++) {
             outs << "    ";
-            instructions[i].PrintRawString(pool, outs);
+            instructions[i].PrintRawString(pool, outs, callArgs);
             outs << std::endl;
         }
     }
@@ -105,11 +132,11 @@ namespace tayir {
      * @return 指令
      */
     Ins &IRFragmentBuilder::GetIns(int sub) {
-        if (sub < 0 || sub >= (int)instructions.size()) {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)instructions.size())) {
             //TODO: throw an exception instead of const char *
             throw "Out of boundary!";
         }
-        return instructions.at(sub);
+        return instructions[sub];
     }
 
     /**
@@ -118,18 +145,33 @@ namespace tayir {
      * @param ins 指令
      * @return Builder自身
      */
-    IRFragmentBuilder &IRFragmentBuilder::AppendIns(Ins ins) {
+    IRFragmentBuilder &IRFragmentBuilder::AppendIns(const Ins &ins) {
         instructions.push_back(ins);
         return *this;
     }
 
+    /**
+     * @brief 预留指令空间
+     * 
+     * @param insNum 指令数量
+     * @return Builder自身
+     */
+    IRFragmentBuilder &IRFragmentBuilder::Reserve(int insNum) {
+        instructions.reserve(insNum);
+        return *this;
+    }
+
     /**
      * @brief 构造IRFragment
      * 
+     * 指令列表被移交给IRFragment, 构建后Builder为空
+     * 
      * @return IRFragment
      */
     IRFragment *IRFragmentBuilder::Build() {
-        return new IRFragment(instructions);
+        IRFragment *frag = new IRFragment(std::move(instructions));
+        instructions.clear();
+        return frag;
     }
 
 //---------------------------------------------------------
@@ -145,12 +187,9 @@ namespace tayir {
      * @param name 基本块名
      * @param argList 参数列表
      */
-    IRBasicBlock::IRBasicBlock(IRFragment *frag, std::string name, std::vector<Argument> argList) 
-        : frag(frag), name(name), argNum(argList.size()), args(new Argument[argNum])
+    IRBasicBlock::IRBasicBlock(IRFragment *frag, Name name, std::vector<Argument> &&argList) 
+        : frag(frag), name(name), argNum(argList.size()), args(std::move(argList))
     {
-        for (int i = 0 ; i < argNum ; i ++) {
-            args[i] = argList.at(i);
-        }
     }
     
     /**
@@ -158,9 +197,6 @@ namespace tayir {
      * 
      */
     IRBasicBlock::~IRBasicBlock() {
-        if (args != NULL) {
-            delete[] args;
-        }
         if (frag != NULL) {
             delete frag;
         }
@@ -201,7 +237,7 @@ namespace tayir {
      * @return 参数
      */
     const Argument IRBasicBlock::GetArg(int sub) const {
-        if (sub < 0 || sub >= argNum) {
+        if (TAYIR_OUT_OF_BOUND(sub, argNum)) {
             //TODO: throw an exception
             return Argument();
         }
@@ -213,18 +249,41 @@ namespace tayir {
      * 
      * @return 基本块名
      */
-    std::string IRBasicBlock::GetName() const {
+    const Name IRBasicBlock::GetName() const {
         return name;
     }
 
+    /**
+     * @brief 获取指令表占用字节数
+     * 
+     * 按容量计算
+     * 
+     * @return 字节数
+     */
+    const size_t IRBasicBlock::GetInsReservedBytes() const {
+        return frag != NULL ? frag->GetInsReservedBytes() : 0;
+    }
+
+    /**
+     * @brief 获取占用字节数
+     * 
+     * 基本块与片段对象及参数表, 不含指令表
+     * 
+     * @return 字节数
+     */
+    const size_t IRBasicBlock::GetReservedBytes() const {
+        return sizeof(IRBasicBlock) + (frag != NULL ? sizeof(IRFragment) : 0) + sizeof(Argument) * args.capacity();
+    }
+
     /**
      * @brief 打印
      * 
      * @param man 类型管理器
      * @param pool 操作数池
-     * @param stream 输出流 
+     * @param outs 输出流 
+     * @param callArgs 所在函数的调用参数流
      */
-    void IRBasicBlock::PrintRawString(TypeManager &man, OperandPool &pool, std::ostream &outs) const {
+    void IRBasicBlock::PrintRawString(TypeManager &man, OperandPool &pool, std::ostream &outs, Span<const int> callArgs) const {
         outs << name;
         if (argNum != 0) {
             outs << "(";
@@ -236,7 +295,7 @@ namespace tayir {
             outs << ")";
         }
         outs << ":\n";
-        frag->PrintRawString(pool, outs);
+        frag->PrintRawString(pool, outs, callArgs);
     }
 
 //--------------------------------------
@@ -273,11 +332,22 @@ namespace tayir {
      * @param ins 指令
      * @return Builder自身
      */
-    IRBasicBlockBuilder &IRBasicBlockBuilder::AppendIns(Ins ins) {
+    IRBasicBlockBuilder &IRBasicBlockBuilder::AppendIns(const Ins &ins) {
         frag.AppendIns(ins);
         return *this;
     }
 
+    /**
+     * @brief 预留指令空间
+     * 
+     * @param insNum 指令数量
+     * @return Builder自身
+     */
+    IRBasicBlockBuilder &IRBasicBlockBuilder::Reserve(int insNum) {
+        frag.Reserve(insNum);
+        return *this;
+    }
+
     /**
      * @brief 获取参数
      * 
@@ -285,11 +355,11 @@ namespace tayir {
      * @return 参数
      */
     Argument &IRBasicBlockBuilder::GetArg(int sub) {
-        if (sub < 0 || sub >= (int)args.size()) {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)args.size())) {
             //TODO: throw an exception instead of throw const char *
             throw "out of boundary!";
         }
-        return args.at(sub);
+        return args[sub];
     }
     /**
      * @brief 追加参数
@@ -297,7 +367,7 @@ namespace tayir {
      * @param arg 参数
      * @return Builder自身
      */
-    IRBasicBlockBuilder &IRBasicBlockBuilder::AppendArg(Argument arg) {
+    IRBasicBlockBuilder &IRBasicBlockBuilder::AppendArg(const Argument &arg) {
         args.push_back(arg);
         return *this;
     }
@@ -305,11 +375,15 @@ namespace tayir {
     /**
      * @brief 构建IR基本块
      * 
+     * 指令与参数被移交给基本块, 构建后Builder为空
+     * 
      * @param name 基本块名
      * @return IR基本块
      */
-    IRBasicBlock *IRBasicBlockBuilder::Build(std::string name) {
-        return new IRBasicBlock(frag.Build(), name, args);
+    IRBasicBlock *IRBasicBlockBuilder::Build(Name name) {
+        IRBasicBlock *block = new IRBasicBlock(frag.Build(), name, std::move(args));
+        args.clear();
+        return block;
     }
 
 //---------------------------------------------------------
@@ -345,13 +419,17 @@ namespace tayir {
      * @param blockList 基本块表
      * @param decl 函数声明
      */
-    IRFunction::IRFunction(std::vector<IRBasicBlock *> blockList, IRFuncDecl decl) 
-        : decl(decl), insNum(0), blockNum(blockList.size()), blocks(new IRBasicBlock*[blockNum])
+    IRFunction::IRFunction(std::vector<IRBasicBlock *> &&blockList, IRFuncDecl &&decl, std::vector<int> &&argStream) 
+        : decl(std::move(decl)), insNum(0), blockNum(blockList.size()), blocks(std::move(blockList)), blockOffsets(blockNum + 1),
+          callArgs(std::move(argStream))
     {
+        blockIndex.reserve(blockNum);
         for (int i = 0 ; i < blockNum ; i ++) {
-            insNum += blockList.at(i)->GetInsNum();
-            blocks[i] = blockList.at(i);
+            blockOffsets[i] = insNum;
+            insNum += blocks[i]->GetInsNum();
+            blockIndex.insert(std::make_pair(blocks[i]->GetName(), i));
         }
+        blockOffsets[blockNum] = insNum;
     }
     
     /**
@@ -359,6 +437,10 @@ namespace tayir {
      * 
      */
     IRFunction::~IRFunction() {
+        for (IRBasicBlock *block : blocks) {
+            delete block;
+        }
+        blocks.clear();
     }
     
     /**
@@ -377,18 +459,8 @@ namespace tayir {
      * @return 指令
      */
     const Ins IRFunction::GetIns(int sub) const {
-        if (sub < 0 || sub >= insNum) {
-            //TODO: throw an exception instead of throw const char *
-            throw "Out of boundary!";
-        }
-        for (int i = 0 ; i < blockNum ; i ++) {
-            if (sub < blocks[i]->GetInsNum()) {
-                return blocks[i]->GetIns(i);
-            }
-            sub -= blocks[i]->GetInsNum();
-        }
-        //TODO: throw an exception instead of throw const char *
-        throw "Unreachable!";
+        int block = GetBlockOfIns(sub);
+        return blocks[block]->GetIns(sub - blockOffsets[block]);
     }
     
     /**
@@ -407,37 +479,290 @@ namespace tayir {
      * @return 基本块
      */
     const IRBasicBlock *IRFunction::GetBlock(int sub) const {
-        if (sub < 0 || sub >= blockNum) {
+        if (TAYIR_OUT_OF_BOUND(sub, blockNum)) {
             //TODO: throw an exception instead of throw const char *
             throw "Out of boundary!";
         }
         return blocks[sub];
     }
     
+    /**
+     * @brief 获取可修改的基本块
+     * 
+     * @param sub 下标
+     * @return 基本块
+     */
+    IRBasicBlock *IRFunction::GetBlock(int sub) {
+        if (TAYIR_OUT_OF_BOUND(sub, blockNum)) {
+            //TODO: throw an exception instead of throw const char *
+            throw "Out of boundary!";
+        }
+        return blocks[sub];
+    }
+    
+    /**
+     * @brief 解析基本块中的跳转标号
+     * 
+     * 已解析的标号不再查找, 无法解析的标号保持未解析
+     * 
+     * @param block 基本块
+     * @param pool 操作数池
+     */
+    void IRFunction::ResolveLabels(const IRBasicBlock *block, OperandPool &pool) {
+        for (const Ins &ins : block->Instructions()) {
+            for (int i = 0 ; i < GetSuccessorNum(ins) ; i ++) {
+                int labelOp = ins.GetInsType() == InsType::BR ? (i == 0 ? ins.GetIfOp() : ins.GetElseOp()) : ins.GetSrc1Op();
+                if (labelOp == -1 || labelTab.count(labelOp) != 0) {
+                    continue;
+                }
+                int target = GetBlockSub(pool.GetName(labelOp));
+                if (target != -1) {
+                    labelTab.insert(std::make_pair(labelOp, target));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 替换基本块
+     * 
+     * 原基本块被释放, 新基本块须与其同名(已有跳转标号的解析结果保持有效)
+     * 新基本块中的跳转标号随即解析
+     * 
+     * @param sub 下标
+     * @param block 基本块
+     * @param pool 操作数池
+     */
+    void IRFunction::ReplaceBlock(int sub, IRBasicBlock *block, OperandPool &pool) {
+        if (TAYIR_OUT_OF_BOUND(sub, blockNum)) {
+            //TODO: throw an exception instead of throw const char *
+            throw "Out of boundary!";
+        }
+        if (block->GetName() != blocks[sub]->GetName()) {
+            //TODO: throw an exception instead of throw const char *
+            throw "Block name mismatch!";
+        }
+        const int delta = block->GetInsNum() - blocks[sub]->GetInsNum();
+        delete blocks[sub];
+        blocks[sub] = block;
+        for (int i = sub + 1 ; i <= blockNum ; i ++) {
+            blockOffsets[i] += delta;
+        }
+        insNum += delta;
+        ResolveLabels(block, pool);
+    }
+    
     /**
      * @brief 获取基本块
      * 
      * @param name 名称
      * @return 基本块
      */
-    const IRBasicBlock *IRFunction::GetBlock(std::string name) const {
-        for (int i = 0 ; i < blockNum ; i ++) {
-            if (blocks[i]->GetName() == name) {
-                return blocks[i];
-            }
+    const IRBasicBlock *IRFunction::GetBlock(Name name) const {
+        int sub = GetBlockSub(name);
+        if (sub == -1) {
+            return NULL;
         }
-        return NULL;
+        return blocks[sub];
     }
     
+    /**
+     * @brief 获取基本块首指令在函数中的下标
+     * 
+     * @param sub 基本块下标
+     * @return 首指令下标
+     */
+    const int IRFunction::GetBlockOffset(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, blockNum + 1)) {
+            //TODO: throw an exception instead of throw const char *
+            throw "Out of boundary!";
+        }
+        return blockOffsets[sub];
+    }
+
+    /**
+     * @brief 获取指令所在基本块
+     * 
+     * 在前缀和上二分查找, O(log blockNum)
+     * 
+     * @param sub 指令下标
+     * @return 基本块下标
+     */
+    const int IRFunction::GetBlockOfIns(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, insNum)) {
+            //TODO: throw an exception instead of throw const char *
+            throw "Out of boundary!";
+        }
+        // 最后一个首指令下标 <= sub 的基本块, 空基本块会被自动跳过
+        return std::upper_bound(blockOffsets.begin(), blockOffsets.end(), sub) - blockOffsets.begin() - 1;
+    }
+
+    /**
+     * @brief 获取基本块下标
+     * 
+     * @param name 基本块名
+     * @return 基本块下标, 不存在时为-1
+     */
+    const int IRFunction::GetBlockSub(Name name) const {
+        auto iter = blockIndex.find(name);
+        if (iter == blockIndex.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取标号指向的基本块下标
+     * 
+     * @param labelOp 标号操作数ID
+     * @return 基本块下标, 未解析时为-1
+     */
+    const int IRFunction::GetLabelTarget(int labelOp) const {
+        auto iter = labelTab.find(labelOp);
+        if (iter == labelTab.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取后继数量
+     * 
+     * @param ins 跳转指令
+     * @return br为2, goto为1, 其余为0
+     */
+    const int IRFunction::GetSuccessorNum(const Ins &ins) {
+        if (ins.GetInsType() == InsType::BR) {
+            return 2;
+        }
+        if (ins.GetInsType() == InsType::GOTO) {
+            return 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 获取后继基本块下标
+     * 
+     * @param ins 跳转指令
+     * @param which 第几个后继(br: 0为如果, 1为否则)
+     * @return 基本块下标, 不存在时为-1
+     */
+    const int IRFunction::GetSuccessorSub(const Ins &ins, int which) const {
+        if (which < 0 || which >= GetSuccessorNum(ins)) {
+            return -1;
+        }
+        if (ins.GetInsType() == InsType::BR) {
+            return GetLabelTarget(which == 0 ? ins.GetIfOp() : ins.GetElseOp());
+        }
+        // goto的标号位于操作数1
+        return GetLabelTarget(ins.GetSrc1Op());
+    }
+
+    /**
+     * @brief 获取后继基本块
+     * 
+     * @param ins 跳转指令
+     * @param which 第几个后继(br: 0为如果, 1为否则)
+     * @return 基本块, 不存在时为NULL
+     */
+    const IRBasicBlock *IRFunction::GetSuccessorBlock(const Ins &ins, int which) const {
+        int sub = GetSuccessorSub(ins, which);
+        if (sub == -1) {
+            return NULL;
+        }
+        return blocks[sub];
+    }
+
     /**
      * @brief 获取函数声明
      * 
      * @return 函数声明
      */
-    const IRFuncDecl IRFunction::GetDecl() const {
+    const IRFuncDecl &IRFunction::GetDecl() const {
         return decl;
     }
 
+    /**
+     * @brief 获取调用参数段中的参数
+     * 
+     * 不复制参数
+     * 
+     * @param argSpan 调用参数段
+     * @return 参数
+     */
+    Span<const int> IRFunction::GetCallArgs(int argSpan) const {
+        const int offset = GetArgSpanOffset(argSpan);
+        const int count = GetArgSpanCount(argSpan);
+        if (! IsArgSpan(argSpan) || TAYIR_OUT_OF_BOUND(offset + count, (int)callArgs.size() + 1)) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return Span<const int>(callArgs.data() + offset, count);
+    }
+
+    /**
+     * @brief 追加调用参数段
+     * 
+     * 调用参数流可能因此重新分配, 之前取得的参数视图失效
+     * 
+     * @param args 参数
+     * @return 调用参数段
+     */
+    int IRFunction::AppendCallArgs(const std::vector<int> &args) {
+        return AppendArgSpan(callArgs, args);
+    }
+
+    /**
+     * @brief 重映射操作数
+     * 
+     * @param remap 旧ID -> 新ID
+     * @param op 操作数
+     * @return 新操作数
+     */
+    static inline int RemapOperand(Span<const int> remap, int op) {
+        return (op < 0 || IsInlineImm(op)) ? op : remap[op];
+    }
+
+    /**
+     * @brief 重映射操作数池ID
+     * 
+     * 函数移到另一个操作数池时使用(见OperandPool::Import)
+     * 指令与调用参数中的操作数池ID按remap替换, 内联立即数与参数段不变
+     * 
+     * @param remap 旧ID -> 新ID
+     */
+    void IRFunction::RemapOperands(Span<const int> remap) {
+        for (IRBasicBlock *block : blocks) {
+            for (Ins &ins : block->Instructions()) {
+                ins.SetDestOp(RemapOperand(remap, ins.GetDestOp()));
+                ins.SetSrc1Op(RemapOperand(remap, ins.GetSrc1Op()));
+                ins.SetSrc2Op(RemapOperand(remap, ins.GetSrc2Op()));
+            }
+        }
+        for (int &arg : callArgs) {
+            arg = RemapOperand(remap, arg);
+        }
+        // 标号表以操作数ID为键
+        std::unordered_map<int, int> oldLabelTab;
+        oldLabelTab.swap(labelTab);
+        for (const auto &entry : oldLabelTab) {
+            labelTab.insert(std::make_pair(RemapOperand(remap, entry.first), entry.second));
+        }
+    }
+
+    /**
+     * @brief 获取占用字节数
+     * 
+     * 函数对象, 基本块表, 偏移表, 调用参数流与声明参数表, 不含基本块
+     * 
+     * @return 字节数
+     */
+    const size_t IRFunction::GetReservedBytes() const {
+        return sizeof(IRFunction) + sizeof(IRBasicBlock *) * blocks.capacity() + sizeof(int) * blockOffsets.capacity()
+            + sizeof(int) * callArgs.capacity() + sizeof(Argument) * decl.args.capacity();
+    }
+
     /**
      * @brief 打印
      * 
@@ -449,7 +774,7 @@ namespace tayir {
         decl.PrintRawString(man, outs);
         outs << " {" << std::endl;
         for (int i = 0 ; i < blockNum ; i ++) {
-            blocks[i]->PrintRawString(man, pool, outs);
+            blocks[i]->PrintRawString(man, pool, outs, GetCallArgs());
         }
         outs << "}" << std::endl;
     }
@@ -500,11 +825,11 @@ namespace tayir {
      * @return 基本块
      */
     IRBasicBlock *IRFunctionBuilder::GetBlock(int sub) {
-        if (sub < 0 || sub >= (int)blocks.size()) {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)blocks.size())) {
             //TODO: throw an exception
             return NULL;
         }
-        return blocks.at(sub);
+        return blocks[sub];
     }
     
     /**
@@ -515,10 +840,32 @@ namespace tayir {
      * @return Builder自身
      */
     IRFunctionBuilder &IRFunctionBuilder::ReplaceBlock(int sub, IRBasicBlock *block) {
-        delete blocks.at(sub);
-        blocks.at(sub) = block;
+        if (TAYIR_OUT_OF_BOUND(sub, (int)blocks.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        delete blocks[sub];
+        blocks[sub] = block;
         return *this;
     }
+
+    /**
+     * @brief 替换基本块
+     * 
+     * 不抛出异常, 失败时block不被接管
+     * 
+     * @param sub 下标
+     * @param block 基本块
+     * @return 状态码
+     */
+    IRStatus IRFunctionBuilder::TryReplaceBlock(int sub, IRBasicBlock *block) {
+        if (sub < 0 || sub >= (int)blocks.size()) {
+            return IRStatus::OUT_OF_BOUNDARY;
+        }
+        delete blocks[sub];
+        blocks[sub] = block;
+        return IRStatus::OK;
+    }
     
     /**
      * @brief 追加基本块
@@ -530,18 +877,98 @@ namespace tayir {
         blocks.push_back(block);
         return *this;
     }
+
+    /**
+     * @brief 追加调用参数段
+     * 
+     * 参数存放在函数的调用参数流中, call指令以返回的参数段作为操作数2
+     * 
+     * @param args 参数
+     * @return 调用参数段
+     */
+    int IRFunctionBuilder::AppendCallArgs(const std::vector<int> &args) {
+        return AppendArgSpan(callArgs, args);
+    }
     
+    /**
+     * @brief 预留基本块空间
+     * 
+     * @param blockNum 基本块数量
+     * @return Builder自身
+     */
+    IRFunctionBuilder &IRFunctionBuilder::Reserve(int blockNum) {
+        blocks.reserve(blockNum);
+        return *this;
+    }
+
     /**
      * @brief 构建IRFunction
      * 
+     * 不解析跳转标号
+     * 基本块表与函数声明被移交给IRFunction, 构建后Builder为空
+     * 
      * @return IRFunction
      */
     IRFunction *IRFunctionBuilder::Build() {
-        IRFunction *func = new IRFunction(blocks, decl);
+        IRFunction *func = new IRFunction(std::move(blocks), std::move(decl), std::move(callArgs));
         blocks.clear();
+        decl = IRFuncDecl();
+        callArgs.clear();
+        return func;
+    }
+
+    /**
+     * @brief 构建IRFunction
+     * 
+     * 同时建立标号操作数到基本块的映射表
+     * 
+     * @param pool 操作数池
+     * @return IRFunction
+     */
+    IRFunction *IRFunctionBuilder::Build(OperandPool &pool) {
+        IRFunction *func = Build();
+        for (const IRBasicBlock *block : func->blocks) {
+            func->ResolveLabels(block, pool);
+        }
         return func;
     }
 
+    /**
+     * @brief 构建IRFunction
+     * 
+     * 不抛出异常, 先检查基本块是否重名以及跳转标号能否全部解析
+     * 失败时不构建, Builder保持不变
+     * 
+     * @param pool 操作数池
+     * @param func 输出: IRFunction, 失败时为NULL
+     * @return 状态码
+     */
+    IRStatus IRFunctionBuilder::TryBuild(OperandPool &pool, IRFunction *&func) {
+        func = NULL;
+        std::unordered_map<Name, int> names;
+        names.reserve(blocks.size());
+        for (int i = 0 ; i < (int)blocks.size() ; i ++) {
+            if (! names.insert(std::make_pair(blocks[i]->GetName(), i)).second) {
+                return IRStatus::DUPLICATE_BLOCK;
+            }
+        }
+        for (const IRBasicBlock *block : blocks) {
+            for (const Ins &ins : block->Instructions()) {
+                for (int i = 0 ; i < IRFunction::GetSuccessorNum(ins) ; i ++) {
+                    int labelOp = ins.GetInsType() == InsType::BR ? (i == 0 ? ins.GetIfOp() : ins.GetElseOp()) : ins.GetSrc1Op();
+                    // 跳转位置必须是标号操作数, 不接受符号, 内联立即数与参数段
+                    if (labelOp < 0 || IsInlineImm(labelOp) || labelOp >= pool.GetOperandNum()
+                        || pool.GetOperandType(labelOp) != OperandType::LABEL
+                        || names.count(pool.GetName(labelOp)) == 0) {
+                        return IRStatus::UNRESOLVED_LABEL;
+                    }
+                }
+            }
+        }
+        func = Build(pool);
+        return IRStatus::OK;
+    }
+
 //--------------------------------------
 
     /**
@@ -558,7 +985,7 @@ namespace tayir {
      * @param name 函数名
      * @return 函数声明
      */
-    const IRFuncDecl IRFuncDeclTab::GetFuncDecl(std::string name) const {
+    const IRFuncDecl &IRFuncDeclTab::GetFuncDecl(Name name) const {
         if (declTab.count(name) == 0) {
             //TODO: throw an exception instead of const char *
             throw "don't exist key!";
@@ -566,12 +993,37 @@ namespace tayir {
         return declTab.at(name);
     }
 
+    /**
+     * @brief 获取函数声明数量
+     * 
+     * @return 函数声明数量
+     */
+    const int IRFuncDeclTab::GetFuncDeclNum() const {
+        return declTab.size();
+    }
+
+    /**
+     * @brief 获取占用字节数
+     * 
+     * 哈希表的节点按值加一个指针估算
+     * 
+     * @return 字节数
+     */
+    const size_t IRFuncDeclTab::GetReservedBytes() const {
+        size_t bytes = sizeof(void *) * declTab.bucket_count() + (sizeof(std::pair<const Name, IRFuncDecl>) + sizeof(void *)) * declTab.size();
+        for (const auto &entry : declTab) {
+            bytes += sizeof(Argument) * entry.second.args.capacity();
+        }
+        return bytes;
+    }
+
     /**
      * @brief 追加函数声明
      * 
      * @param decl 函数声明
      */
     void IRFuncDeclTab::AppendFuncDecl(IRFuncDecl decl) {
-        declTab.insert(std::make_pair(decl.name, decl));
+        Name name = decl.name;
+        declTab.insert(std::make_pair(name, std::move(decl)));
     }
 }
\ No newline at end of file
@@ -14,8 +14,11 @@
 
 #include <ir/ins.h>
 #include <ir/type.h>
+#include <ir/status.h>
+#include <utils/span.h>
 
 #include <vector>
+#include <unordered_map>
 
 namespace tayir {
     /**
@@ -39,6 +42,65 @@ namespace tayir {
         virtual const Ins GetIns(int sub) const = 0;
     };
 
+    /**
+     * @brief 静态分派的IR切片基类
+     * 
+     * @see IRSlice
+     * 
+     * CRTP基类, 借助派生类的Instructions()提供不经过虚函数的遍历与统计
+     * 以const IRStaticSlice<Slice> &为参数的模板遍可被完全内联
+     * 
+     * @tparam Derived 派生类
+     */
+    template<typename Derived> class IRStaticSlice {
+    protected:
+        /**
+         * @brief 获取派生类自身
+         * 
+         * @return 派生类自身
+         */
+        const Derived &Self() const {
+            return static_cast<const Derived &>(*this);
+        }
+    public:
+        /**
+         * @brief 遍历指令
+         * 
+         * @tparam Fn 函数类型
+         * @param fn 对每条指令调用的函数
+         */
+        template<typename Fn> void ForEachIns(Fn &&fn) const {
+            for (const Ins &ins : Self().Instructions()) {
+                fn(ins);
+            }
+        }
+        /**
+         * @brief 统计满足条件的指令数
+         * 
+         * @tparam Pred 谓词类型
+         * @param pred 谓词
+         * @return 指令数
+         */
+        template<typename Pred> const int CountIf(Pred &&pred) const {
+            int count = 0;
+            for (const Ins &ins : Self().Instructions()) {
+                count += pred(ins) ? 1 : 0;
+            }
+            return count;
+        }
+        /**
+         * @brief 统计指定类型的指令数
+         * 
+         * @param type 指令类型
+         * @return 指令数
+         */
+        const int CountIns(InsType type) const {
+            return CountIf([type](const Ins &ins) {
+                return ins.GetInsType() == type;
+            });
+        }
+    };
+
     /**
      * @brief IR片段
      * @see IRBasicBlock
@@ -46,18 +108,20 @@ namespace tayir {
      * 存储IR指令程序片段
      * 
      */
-    class IRFragment: public IRSlice {
+    class IRFragment: public IRSlice, public IRStaticSlice<IRFragment> {
     protected:
         /** 指令数 */
         const int insNum;
         /** 指令数组 */
-        Ins *instructions;
+        std::vector<Ins> instructions;
         /**
          * @brief IRFragment构造函数
          * 
+         * 直接接管指令列表的存储, 不复制指令
+         * 
          * @param insList 指令列表
          */
-        IRFragment(std::vector<Ins> insList);
+        IRFragment(std::vector<Ins> &&insList);
     public:
         /**
          * @brief IRFragment析构函数
@@ -77,13 +141,42 @@ namespace tayir {
          * @return 指令
          */
         virtual const Ins GetIns(int sub) const override;
+        /**
+         * @brief 获取指令视图
+         * 
+         * 非虚且不做边界检查, 供遍历指令的热循环使用
+         * 
+         * @return 指令视图
+         */
+        Span<const Ins> Instructions() const {
+            return Span<const Ins>(instructions.data(), insNum);
+        }
+        /**
+         * @brief 获取可修改的指令视图
+         * 
+         * 供就地改写操作数的变换使用
+         * 
+         * @return 指令视图
+         */
+        Span<Ins> Instructions() {
+            return Span<Ins>(instructions.data(), insNum);
+        }
         /**
          * @brief 打印
          * 
          * @param pool 操作数池
          * @param outs 输出流 
+         * @param callArgs 所在函数的调用参数流
          */
-        void PrintRawString(OperandPool &pool, std::ostream &outs) const;
+        void PrintRawString(OperandPool &pool, std::ostream &outs, Span<const int> callArgs = Span<const int>()) const;
+        /**
+         * @brief 获取指令表占用字节数
+         * 
+         * 按容量计算
+         * 
+         * @return 字节数
+         */
+        const size_t GetInsReservedBytes() const;
         friend class IRFragmentBuilder;
     };
 
@@ -121,10 +214,19 @@ namespace tayir {
          * @param ins 指令
          * @return Builder自身
          */
-        IRFragmentBuilder &AppendIns(Ins ins);
+        IRFragmentBuilder &AppendIns(const Ins &ins);
+        /**
+         * @brief 预留指令空间
+         * 
+         * @param insNum 指令数量
+         * @return Builder自身
+         */
+        IRFragmentBuilder &Reserve(int insNum);
         /**
          * @brief 构造IRFragment
          * 
+         * 指令列表被移交给IRFragment, 构建后Builder为空
+         * 
          * @return IRFragment
          */
         IRFragment *Build();
@@ -139,16 +241,16 @@ namespace tayir {
      * 控制流基本跳转单位
      * 
      */
-    class IRBasicBlock : public IRSlice {
+    class IRBasicBlock : public IRSlice, public IRStaticSlice<IRBasicBlock> {
     protected:
         /** IR片段 */
         IRFragment *frag;
         /** 基本块名 */
-        std::string name;
+        Name name;
         /** 偏移 */
         const int argNum;
         /** 基本块参数表 */
-        Argument *args;
+        std::vector<Argument> args;
         /**
          * @brief IRBasicBlock构造函数
          * 
@@ -156,7 +258,7 @@ namespace tayir {
          * @param name 基本块名
          * @param argList 参数列表
          */
-        IRBasicBlock(IRFragment *frag, std::string name, std::vector<Argument> argList);
+        IRBasicBlock(IRFragment *frag, Name name, std::vector<Argument> &&argList);
     public:
         /**
          * @brief IRBasicBlock析构函数
@@ -176,6 +278,22 @@ namespace tayir {
          * @return 指令
          */
         virtual const Ins GetIns(int sub) const override;
+        /**
+         * @brief 获取指令视图
+         * 
+         * @return 指令视图
+         */
+        Span<const Ins> Instructions() const {
+            return frag->Instructions();
+        }
+        /**
+         * @brief 获取可修改的指令视图
+         * 
+         * @return 指令视图
+         */
+        Span<Ins> Instructions() {
+            return frag->Instructions();
+        }
         /**
          * @brief 获取获取参数数量
          * 
@@ -194,15 +312,32 @@ namespace tayir {
          * 
          * @return 基本块名
          */
-        std::string GetName() const;
+        const Name GetName() const;
         /**
          * @brief 打印
          * 
          * @param man 类型管理器
          * @param pool 操作数池
          * @param outs 输出流 
+         * @param callArgs 所在函数的调用参数流
          */
-        void PrintRawString(TypeManager &man, OperandPool &pool, std::ostream &outs) const;
+        void PrintRawString(TypeManager &man, OperandPool &pool, std::ostream &outs, Span<const int> callArgs = Span<const int>()) const;
+        /**
+         * @brief 获取指令表占用字节数
+         * 
+         * 按容量计算
+         * 
+         * @return 字节数
+         */
+        const size_t GetInsReservedBytes() const;
+        /**
+         * @brief 获取占用字节数
+         * 
+         * 基本块与片段对象及参数表, 不含指令表
+         * 
+         * @return 字节数
+         */
+        const size_t GetReservedBytes() const;
         friend class IRBasicBlockBuilder;
     };
 
@@ -243,7 +378,14 @@ namespace tayir {
          * @param ins 指令
          * @return Builder自身
          */
-        IRBasicBlockBuilder &AppendIns(Ins ins);
+        IRBasicBlockBuilder &AppendIns(const Ins &ins);
+        /**
+         * @brief 预留指令空间
+         * 
+         * @param insNum 指令数量
+         * @return Builder自身
+         */
+        IRBasicBlockBuilder &Reserve(int insNum);
         /**
          * @brief 获取参数
          * 
@@ -257,14 +399,16 @@ namespace tayir {
          * @param arg 参数
          * @return Builder自身
          */
-        IRBasicBlockBuilder &AppendArg(Argument arg);
+        IRBasicBlockBuilder &AppendArg(const Argument &arg);
         /**
          * @brief 构建IR基本块
          * 
+         * 指令与参数被移交给基本块, 构建后Builder为空
+         * 
          * @param name 基本块名
          * @return IR基本块
          */
-        IRBasicBlock *Build(std::string name);
+        IRBasicBlock *Build(Name name);
     };
 
     /**
@@ -280,7 +424,7 @@ namespace tayir {
         /** 参数 */
         std::vector<Argument> args;
         /** 名称 */
-        std::string name;
+        Name name;
         /** 返回类型 */
         int returnTypeId;
         /** 调用约定 */
@@ -300,7 +444,7 @@ namespace tayir {
      * 程序接口的基本单位
      * 
      */
-    class IRFunction : public IRSlice {
+    class IRFunction : public IRSlice, public IRStaticSlice<IRFunction> {
     protected:
         /** 函数声明 */
         const IRFuncDecl decl;
@@ -309,15 +453,50 @@ namespace tayir {
         /** 函数基本块数量 */
         int blockNum;
         /** 函数基本块表 */
-        IRBasicBlock **blocks;
+        std::vector<IRBasicBlock *> blocks;
+        /** 基本块首指令下标(前缀和, 共blockNum + 1项) */
+        std::vector<int> blockOffsets;
+        /** 基本块名 -> 基本块下标 */
+        std::unordered_map<Name, int> blockIndex;
+        /** 标号操作数ID -> 基本块下标 */
+        std::unordered_map<int, int> labelTab;
+        /** 调用参数流 */
+        std::vector<int> callArgs;
         /**
          * @brief IRFunction构造函数
          * 
          * @param blockList 基本块表
          * @param decl 函数声明
+         * @param argStream 调用参数流
          */
-        IRFunction(std::vector<IRBasicBlock *> blockList, IRFuncDecl decl);
+        IRFunction(std::vector<IRBasicBlock *> &&blockList, IRFuncDecl &&decl, std::vector<int> &&argStream);
+        /**
+         * @brief 解析基本块中的跳转标号
+         * 
+         * 已解析的标号不再查找, 无法解析的标号保持未解析
+         * 
+         * @param block 基本块
+         * @param pool 操作数池
+         */
+        void ResolveLabels(const IRBasicBlock *block, OperandPool &pool);
     public:
+        /**
+         * @brief 删除默认复制构造函数
+         * 
+         * 这个函数出现在这说明该类删除了复制功能(函数持有并释放其基本块)
+         * 
+         * @param other 函数
+         */
+        IRFunction(const IRFunction &other) = delete;
+        /**
+         * @brief 删除默认赋值函数
+         * 
+         * 这个函数出现在这说明该类删除了赋值功能
+         * 
+         * @param other 函数
+         * @return 函数
+         */
+        IRFunction &operator=(const IRFunction &other) = delete;
         /**
          * @brief IRFunction析构函数
          * 
@@ -349,19 +528,131 @@ namespace tayir {
          * @return 基本块
          */
         const IRBasicBlock *GetBlock(int sub) const;
+        /**
+         * @brief 获取可修改的基本块
+         * 
+         * @param sub 下标
+         * @return 基本块
+         */
+        IRBasicBlock *GetBlock(int sub);
+        /**
+         * @brief 替换基本块
+         * 
+         * 原基本块被释放, 新基本块须与其同名(已有跳转标号的解析结果保持有效)
+         * 新基本块中的跳转标号随即解析
+         * 
+         * @param sub 下标
+         * @param block 基本块
+         * @param pool 操作数池
+         */
+        void ReplaceBlock(int sub, IRBasicBlock *block, OperandPool &pool);
         /**
          * @brief 获取基本块
          * 
          * @param name 名称
          * @return 基本块
          */
-        const IRBasicBlock *GetBlock(std::string name) const;
+        const IRBasicBlock *GetBlock(Name name) const;
+        /**
+         * @brief 获取基本块首指令在函数中的下标
+         * 
+         * @param sub 基本块下标
+         * @return 首指令下标
+         */
+        const int GetBlockOffset(int sub) const;
+        /**
+         * @brief 获取指令所在基本块
+         * 
+         * @param sub 指令下标
+         * @return 基本块下标
+         */
+        const int GetBlockOfIns(int sub) const;
+        /**
+         * @brief 获取基本块下标
+         * 
+         * @param name 基本块名
+         * @return 基本块下标, 不存在时为-1
+         */
+        const int GetBlockSub(Name name) const;
+        /**
+         * @brief 获取标号指向的基本块下标
+         * 
+         * @param labelOp 标号操作数ID
+         * @return 基本块下标, 未解析时为-1
+         */
+        const int GetLabelTarget(int labelOp) const;
+        /**
+         * @brief 获取后继数量
+         * 
+         * @param ins 跳转指令
+         * @return br为2, goto为1, 其余为0
+         */
+        static const int GetSuccessorNum(const Ins &ins);
+        /**
+         * @brief 获取后继基本块下标
+         * 
+         * @param ins 跳转指令
+         * @param which 第几个后继(br: 0为如果, 1为否则)
+         * @return 基本块下标, 不存在时为-1
+         */
+        const int GetSuccessorSub(const Ins &ins, int which) const;
+        /**
+         * @brief 获取后继基本块
+         * 
+         * @param ins 跳转指令
+         * @param which 第几个后继(br: 0为如果, 1为否则)
+         * @return 基本块, 不存在时为NULL
+         */
+        const IRBasicBlock *GetSuccessorBlock(const Ins &ins, int which) const;
         /**
          * @brief 获取函数声明
          * 
          * @return 函数声明
          */
-        const IRFuncDecl GetDecl() const;
+        const IRFuncDecl &GetDecl() const;
+        /**
+         * @brief 获取调用参数流
+         * 
+         * @return 调用参数流
+         */
+        Span<const int> GetCallArgs() const {
+            return Span<const int>(callArgs.data(), callArgs.size());
+        }
+        /**
+         * @brief 获取可修改的调用参数流
+         * 
+         * @return 调用参数流
+         */
+        Span<int> GetCallArgs() {
+            return Span<int>(callArgs.data(), callArgs.size());
+        }
+        /**
+         * @brief 获取调用参数段中的参数
+         * 
+         * 不复制参数
+         * 
+         * @param argSpan 调用参数段
+         * @return 参数
+         */
+        Span<const int> GetCallArgs(int argSpan) const;
+        /**
+         * @brief 追加调用参数段
+         * 
+         * 调用参数流可能因此重新分配, 之前取得的参数视图失效
+         * 
+         * @param args 参数
+         * @return 调用参数段
+         */
+        int AppendCallArgs(const std::vector<int> &args);
+        /**
+         * @brief 重映射操作数池ID
+         * 
+         * 函数移到另一个操作数池时使用(见OperandPool::Import)
+         * 指令与调用参数中的操作数池ID按remap替换, 内联立即数与参数段不变
+         * 
+         * @param remap 旧ID -> 新ID
+         */
+        void RemapOperands(Span<const int> remap);
         /**
          * @brief 打印
          * 
@@ -370,6 +661,193 @@ namespace tayir {
          * @param outs 输出流 
          */
         void PrintRawString(TypeManager &man, OperandPool &pool, std::ostream &outs) const;
+        /**
+         * @brief 函数指令迭代器
+         * 
+         * 按顺序遍历所有基本块中的指令
+         * 块内直接在指令视图上前进, 仅在跨块时访问基本块表
+         * 
+         */
+        class InsIterator {
+        protected:
+            /** 函数 */
+            const IRFunction *func;
+            /** 基本块下标 */
+            int blockSub;
+            /** 块内指令下标 */
+            int insSub;
+            /** 当前基本块的指令视图 */
+            Span<const Ins> segment;
+            /**
+             * @brief 跳过空基本块
+             * 
+             */
+            void SkipEmptyBlocks() {
+                while (blockSub < func->blockNum && (size_t)insSub >= segment.GetSize()) {
+                    blockSub ++;
+                    insSub = 0;
+                    if (blockSub < func->blockNum) {
+                        segment = func->blocks[blockSub]->Instructions();
+                    }
+                }
+            }
+        public:
+            /**
+             * @brief InsIterator构造函数
+             * 
+             * @param func 函数
+             * @param blockSub 基本块下标
+             */
+            InsIterator(const IRFunction *func, int blockSub)
+                : func(func), blockSub(blockSub), insSub(0)
+            {
+                if (blockSub < func->blockNum) {
+                    segment = func->blocks[blockSub]->Instructions();
+                    SkipEmptyBlocks();
+                }
+            }
+            /**
+             * @brief 获取指令
+             * 
+             * @return 指令
+             */
+            const Ins &operator*() const {
+                return segment[insSub];
+            }
+            /**
+             * @brief 前进
+             * 
+             * @return 迭代器自身
+             */
+            InsIterator &operator++() {
+                insSub ++;
+                SkipEmptyBlocks();
+                return *this;
+            }
+            /**
+             * @brief 获取基本块下标
+             * 
+             * @return 基本块下标
+             */
+            const int GetBlockSub() const {
+                return blockSub;
+            }
+            /**
+             * @brief 获取块内指令下标
+             * 
+             * @return 块内指令下标
+             */
+            const int GetInsSub() const {
+                return insSub;
+            }
+            /**
+             * @brief 判等
+             * 
+             * @param other 另一个迭代器
+             * @return 是否相等
+             */
+            bool operator==(const InsIterator &other) const {
+                return blockSub == other.blockSub && insSub == other.insSub;
+            }
+            /**
+             * @brief 判不等
+             * 
+             * @param other 另一个迭代器
+             * @return 是否不等
+             */
+            bool operator!=(const InsIterator &other) const {
+                return ! (*this == other);
+            }
+        };
+        /**
+         * @brief 函数指令范围
+         * 
+         * 由各基本块的指令视图首尾相接组成
+         * 可用范围for逐条遍历, 也可按段取出连续视图在内层循环中遍历
+         * 
+         */
+        class InsRange {
+        protected:
+            /** 函数 */
+            const IRFunction *func;
+        public:
+            /**
+             * @brief InsRange构造函数
+             * 
+             * @param func 函数
+             */
+            InsRange(const IRFunction *func) : func(func) {
+            }
+            /**
+             * @brief 获取段数
+             * 
+             * @return 段数(即基本块数量)
+             */
+            const int GetSegmentNum() const {
+                return func->blockNum;
+            }
+            /**
+             * @brief 获取段
+             * 
+             * 不做边界检查
+             * 
+             * @param sub 段下标(即基本块下标)
+             * @return 该基本块的指令视图
+             */
+            Span<const Ins> GetSegment(int sub) const {
+                return func->blocks[sub]->Instructions();
+            }
+            /**
+             * @brief 获取首指令迭代器
+             * 
+             * @return 迭代器
+             */
+            InsIterator begin() const {
+                return InsIterator(func, 0);
+            }
+            /**
+             * @brief 获取尾后迭代器
+             * 
+             * @return 迭代器
+             */
+            InsIterator end() const {
+                return InsIterator(func, func->blockNum);
+            }
+        };
+        /**
+         * @brief 获取指令范围
+         * 
+         * 非虚且不做边界检查, 供遍历指令的热循环使用
+         * 
+         * @return 指令范围
+         */
+        InsRange Instructions() const {
+            return InsRange(this);
+        }
+        /**
+         * @brief 获取首指令迭代器
+         * 
+         * @return 迭代器
+         */
+        InsIterator begin() const {
+            return InsIterator(this, 0);
+        }
+        /**
+         * @brief 获取尾后迭代器
+         * 
+         * @return 迭代器
+         */
+        InsIterator end() const {
+            return InsIterator(this, blockNum);
+        }
+        /**
+         * @brief 获取占用字节数
+         * 
+         * 函数对象, 基本块表, 偏移表, 调用参数流与声明参数表, 不含基本块
+         * 
+         * @return 字节数
+         */
+        const size_t GetReservedBytes() const;
         friend class IRFunctionBuilder;
     };
 
@@ -383,6 +861,8 @@ namespace tayir {
     protected:
         /** 函数声明 */
         IRFuncDecl decl;
+        /** 调用参数流 */
+        std::vector<int> callArgs;
         /** 函数基本块表 */
         std::vector<IRBasicBlock *> blocks;
     public:
@@ -433,6 +913,16 @@ namespace tayir {
          * @return Builder自身
          */
         IRFunctionBuilder &ReplaceBlock(int sub, IRBasicBlock *block);
+        /**
+         * @brief 替换基本块
+         * 
+         * 不抛出异常, 失败时block不被接管
+         * 
+         * @param sub 下标
+         * @param block 基本块
+         * @return 状态码
+         */
+        IRStatus TryReplaceBlock(int sub, IRBasicBlock *block);
         /**
          * @brief 追加基本块
          * 
@@ -440,12 +930,51 @@ namespace tayir {
          * @return Builder自身
          */
         IRFunctionBuilder &AppendBlock(IRBasicBlock *block);
+        /**
+         * @brief 追加调用参数段
+         * 
+         * 参数存放在函数的调用参数流中, call指令以返回的参数段作为操作数2
+         * 
+         * @param args 参数
+         * @return 调用参数段
+         */
+        int AppendCallArgs(const std::vector<int> &args);
+        /**
+         * @brief 预留基本块空间
+         * 
+         * @param blockNum 基本块数量
+         * @return Builder自身
+         */
+        IRFunctionBuilder &Reserve(int blockNum);
         /**
          * @brief 构建IRFunction
          * 
+         * 不解析跳转标号
+         * 基本块表与函数声明被移交给IRFunction, 构建后Builder为空
+         * 
          * @return IRFunction
          */
         IRFunction *Build();
+        /**
+         * @brief 构建IRFunction
+         * 
+         * 同时建立标号操作数到基本块的映射表
+         * 
+         * @param pool 操作数池
+         * @return IRFunction
+         */
+        IRFunction *Build(OperandPool &pool);
+        /**
+         * @brief 构建IRFunction
+         * 
+         * 不抛出异常, 先检查基本块是否重名以及跳转标号能否全部解析
+         * 失败时不构建, Builder保持不变
+         * 
+         * @param pool 操作数池
+         * @param func 输出: IRFunction, 失败时为NULL
+         * @return 状态码
+         */
+        IRStatus TryBuild(OperandPool &pool, IRFunction *&func);
     };
 
     /**
@@ -457,7 +986,7 @@ namespace tayir {
     class IRFuncDeclTab {
     protected:
         /** 声明表 */
-        std::map<std::string, IRFuncDecl> declTab;
+        std::unordered_map<Name, IRFuncDecl> declTab;
     public:
         /**
          * @brief IRFuncDeclTab构造函数
@@ -470,12 +999,39 @@ namespace tayir {
          * @param name 函数名
          * @return 函数声明
          */
-        const IRFuncDecl GetFuncDecl(std::string name) const;
+        const IRFuncDecl &GetFuncDecl(Name name) const;
+        /**
+         * @brief 获取函数声明数量
+         * 
+         * @return 函数声明数量
+         */
+        const int GetFuncDeclNum() const;
+        /**
+         * @brief 获取占用字节数
+         * 
+         * 哈希表的节点按值加一个指针估算
+         * 
+         * @return 字节数
+         */
+        const size_t GetReservedBytes() const;
         /**
          * @brief 追加函数声明
          * 
          * @param decl 函数声明
          */
         void AppendFuncDecl(IRFuncDecl decl);
+        /**
+         * @brief 遍历函数声明
+         * 
+         * 顺序不确定
+         * 
+         * @tparam Fn 回调类型
+         * @param fn 回调(参数为const IRFuncDecl &)
+         */
+        template<typename Fn> void ForEachFuncDecl(Fn &&fn) const {
+            for (const auto &entry : declTab) {
+                fn(entry.second);
+            }
+        }
     };
 }
\ No newline at end of file
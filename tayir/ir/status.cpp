@@ -0,0 +1,31 @@
+/**
+ * @file status.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief IR状态码
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/status.h>
+
+namespace tayir {
+    /**
+     * @brief 状态码转字符串
+     * 
+     * @param status 状态码
+     * @return 字符串
+     */
+    const char *ToString(IRStatus status) {
+        switch (status) {
+        case IRStatus::OK: return "ok";
+        case IRStatus::OUT_OF_BOUNDARY: return "out of boundary";
+        case IRStatus::DUPLICATE_BLOCK: return "duplicate block";
+        case IRStatus::UNRESOLVED_LABEL: return "unresolved label";
+        }
+        return "error!";
+    }
+}
\ No newline at end of file
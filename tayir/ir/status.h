@@ -0,0 +1,40 @@
+/**
+ * @file status.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief IR状态码
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+namespace tayir {
+    /**
+     * @brief IR状态码
+     * 
+     * 不抛出异常的Try*接口以此报告错误
+     * 
+     */
+    enum class IRStatus {
+        /** 成功 */
+        OK = 0,
+        /** 下标越界 */
+        OUT_OF_BOUNDARY = 1,
+        /** 基本块重名 */
+        DUPLICATE_BLOCK = 2,
+        /** 跳转标号没有对应的基本块 */
+        UNRESOLVED_LABEL = 3
+    };
+
+    /**
+     * @brief 状态码转字符串
+     * 
+     * @param status 状态码
+     * @return 字符串
+     */
+    const char *ToString(IRStatus status);
+}
\ No newline at end of file
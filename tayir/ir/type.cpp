@@ -11,6 +11,8 @@
  */
 
 #include <ir/type.h>
+#include <utils/check.h>
+#include <algorithm>
 #include <cstring>
 
 namespace tayir {
@@ -162,11 +164,20 @@ namespace tayir {
      * @return 类型
      */
     const Type *TypeManager::GetType(int typeId) const {
-        if (typeId < 0 || typeId >= (int)types.size()) {
+        if (TAYIR_OUT_OF_BOUND(typeId, (int)types.size())) {
             //TODO: throw an exception
             return NULL;
         }
-        return types.at(typeId);
+        return types[typeId];
+    }
+
+    /**
+     * @brief 获取类型数量
+     * 
+     * @return 类型数量
+     */
+    const int TypeManager::GetTypeNum() const {
+        return types.size();
     }
 
     /**
@@ -176,8 +187,28 @@ namespace tayir {
      * @return 类型ID
      */
     const int TypeManager::AppendType(Type *type) {
+        ComplexType *complexType = dynamic_cast<ComplexType *>(type);
+        LayoutKey key;
+        if (complexType != NULL) {
+            key.align = complexType->GetAlign();
+            for (int i = 0 ; i < complexType->GetTypeNum() ; i ++) {
+                key.members.push_back(complexType->GetMemberTypeId(i));
+            }
+            auto iter = layoutIndex.find(key);
+            if (iter != layoutIndex.end()) {
+                // 结构相同, 复用已有类型
+                int typeId = iter->second;
+                nameIndex.insert(std::make_pair(type->name, typeId));
+                delete type;
+                return typeId;
+            }
+        }
         type->typeId = types.size();
         types.push_back(type);
+        nameIndex.insert(std::make_pair(type->name, type->typeId));
+        if (complexType != NULL) {
+            layoutIndex.insert(std::make_pair(std::move(key), type->typeId));
+        }
         return type->typeId;
     }
 
@@ -187,13 +218,75 @@ namespace tayir {
      * @param name 类型名
      * @return 类型ID
      */
-    const int TypeManager::GetTypeId(std::string name) const {
-        for (Type *type : types) {
-            if (type->name == name) {
-                return type->typeId;
+    const int TypeManager::GetTypeId(const std::string &name) const {
+        auto iter = nameIndex.find(name);
+        if (iter == nameIndex.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取类型别名
+     * 
+     * 别名为与类型本身名称不同的类型名, 由AppendType复用已有类型时登记
+     * 
+     * @return (别名, 类型ID)列表, 按类型ID与别名排序
+     */
+    std::vector<std::pair<std::string, int>> TypeManager::GetAliases() const {
+        std::vector<std::pair<std::string, int>> aliases;
+        for (const auto &entry : nameIndex) {
+            if (types[entry.second]->name != entry.first) {
+                aliases.push_back(entry);
             }
         }
-        return -1;
+        std::sort(aliases.begin(), aliases.end(), [](const auto &a, const auto &b) {
+            return a.second != b.second ? a.second < b.second : a.first < b.first;
+        });
+        return aliases;
+    }
+
+    /**
+     * @brief 登记类型别名
+     * 
+     * @param name 别名
+     * @param typeId 类型ID
+     * @return 是否登记(名称已存在或类型不存在时为false)
+     */
+    bool TypeManager::AppendAlias(const std::string &name, int typeId) {
+        if (TAYIR_OUT_OF_BOUND(typeId, (int)types.size())) {
+            return false;
+        }
+        return nameIndex.insert(std::make_pair(name, typeId)).second;
+    }
+
+    /**
+     * @brief 查找复合类型
+     * 
+     * @param members 成员类型列表
+     * @param align 对齐(2^align)
+     * @return 类型ID, 不存在时为-1
+     */
+    const int TypeManager::FindComplexType(const std::vector<int> &members, const int align) const {
+        auto iter = layoutIndex.find(LayoutKey{align, members});
+        if (iter == layoutIndex.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 计算哈希
+     * 
+     * @param key 布局键
+     * @return 哈希值
+     */
+    size_t TypeManager::LayoutKeyHash::operator()(const LayoutKey &key) const {
+        size_t hash = key.align;
+        for (int member : key.members) {
+            hash ^= (size_t)member + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
     }
 
     /**
@@ -345,6 +438,10 @@ namespace tayir {
             delete[] types;
             types = NULL;
         }
+        if (offsets != NULL) {
+            delete[] offsets;
+            offsets = NULL;
+        }
     }
 
     /**
@@ -356,6 +453,15 @@ namespace tayir {
         return typeNum;
     }
 
+    /**
+     * @brief 获取对齐
+     * 
+     * @return 对齐
+     */
+    const int ComplexType::GetAlign() const {
+        return align;
+    }
+
     /**
      * @brief 获取成员类型ID
      * 
@@ -363,7 +469,7 @@ namespace tayir {
      * @return 成员类型
      */
     const int ComplexType::GetMemberTypeId(int sub) const {
-        if (sub < 0 || sub >= typeNum) {
+        if (TAYIR_OUT_OF_BOUND(sub, typeNum)) {
             //TODO: throw an exception
             return -1;
         }
@@ -377,7 +483,7 @@ namespace tayir {
      * @return 成员偏移
      */
     const int ComplexType::GetMemberOffset(int sub) const {
-        if (sub < 0 || sub >= typeNum) {
+        if (TAYIR_OUT_OF_BOUND(sub, typeNum)) {
             //TODO: throw an exception
             return -1;
         }
@@ -416,11 +522,11 @@ namespace tayir {
      * @return 成员类型ID
      */
     int &ComplexTypeBuilder::GetMemberTypeId(int sub) {
-        if (sub < 0 || sub >= (int)types.size()) {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)types.size())) {
             //TODO: throw an exception rather than const char *
             throw "Out of bound!";
         }
-        return types.at(sub);
+        return types[sub];
     }
 
     /**
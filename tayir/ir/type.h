@@ -15,6 +15,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace tayir {
 //---------------------------------------------------------
@@ -204,14 +205,54 @@ namespace tayir {
 //|                                                       |
 //---------------------------------------------------------
 
+    class ComplexType;
+
     /**
      * @brief 类型管理器
      * 
      */
     class TypeManager {
     protected:
+        /**
+         * @brief 复合类型布局键
+         * 
+         * 对齐与成员类型列表相同的复合类型视为同一类型
+         * 
+         */
+        struct LayoutKey {
+            /** 对齐(2^align) */
+            int align;
+            /** 成员类型列表 */
+            std::vector<int> members;
+            /**
+             * @brief 判等
+             * 
+             * @param other 另一个键
+             * @return 是否相等
+             */
+            bool operator==(const LayoutKey &other) const {
+                return align == other.align && members == other.members;
+            }
+        };
+        /**
+         * @brief 复合类型布局键哈希
+         * 
+         */
+        struct LayoutKeyHash {
+            /**
+             * @brief 计算哈希
+             * 
+             * @param key 布局键
+             * @return 哈希值
+             */
+            size_t operator()(const LayoutKey &key) const;
+        };
         /** 类型表 */
         std::vector<Type *> types;
+        /** 类型名索引 */
+        std::unordered_map<std::string, int> nameIndex;
+        /** 复合类型布局索引 */
+        std::unordered_map<LayoutKey, int, LayoutKeyHash> layoutIndex;
         /** i8 ID */
         int idI8;
         /** i16 ID */
@@ -260,9 +301,18 @@ namespace tayir {
          * @return 类型
          */
         const Type *GetType(int typeId) const;
+        /**
+         * @brief 获取类型数量
+         * 
+         * @return 类型数量
+         */
+        const int GetTypeNum() const;
         /**
          * @brief 追加类型
          * 
+         * 若已存在布局相同的复合类型, 则释放type并返回已有类型的ID,
+         * type的名称作为该类型的别名登记
+         * 
          * @param type 类型
          * @return 类型ID
          */
@@ -273,7 +323,31 @@ namespace tayir {
          * @param name 类型名
          * @return 类型ID
          */
-        const int GetTypeId(std::string name) const;
+        const int GetTypeId(const std::string &name) const;
+        /**
+         * @brief 查找复合类型
+         * 
+         * @param members 成员类型列表
+         * @param align 对齐(2^align)
+         * @return 类型ID, 不存在时为-1
+         */
+        const int FindComplexType(const std::vector<int> &members, const int align) const;
+        /**
+         * @brief 获取类型别名
+         * 
+         * 别名为与类型本身名称不同的类型名, 由AppendType复用已有类型时登记
+         * 
+         * @return (别名, 类型ID)列表, 按类型ID与别名排序
+         */
+        std::vector<std::pair<std::string, int>> GetAliases() const;
+        /**
+         * @brief 登记类型别名
+         * 
+         * @param name 别名
+         * @param typeId 类型ID
+         * @return 是否登记(名称已存在或类型不存在时为false)
+         */
+        bool AppendAlias(const std::string &name, int typeId);
         /**
          * @brief 获取 'i8' ID
          * 
@@ -0,0 +1,177 @@
+/**
+ * @file valuenum.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief SSA值编号
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <ir/valuenum.h>
+#include <utils/check.h>
+
+namespace tayir {
+    /**
+     * @brief 追加值
+     * 
+     * @param op 操作数ID
+     * @param kind 种类
+     * @param block 定义所在基本块
+     * @param ins 定义指令在函数中的下标
+     * @return 值
+     */
+    int IRValueNumbering::AppendValue(int op, ValueKind kind, int block, int ins) {
+        int value = operands.size();
+        operands.push_back(op);
+        kinds.push_back(kind);
+        defBlocks.push_back(block);
+        defIns.push_back(ins);
+        if (op != -1) {
+            valueIndex.insert(std::make_pair(op, value));
+        }
+        return value;
+    }
+
+    /**
+     * @brief IRValueNumbering构造函数
+     * 
+     * @param func 函数
+     * @param pool 操作数池
+     */
+    IRValueNumbering::IRValueNumbering(const IRFunction *func, const OperandPool &pool)
+        : resultValues(func->GetInsNum(), -1), blockFirstValues(func->GetBlockNum() + 1)
+    {
+        const std::vector<Argument> &funcArgs = func->GetDecl().args;
+        for (const Argument &arg : funcArgs) {
+            AppendValue(pool.FindSymbol(SymbolScope::LOCAL, arg.GetName()), ValueKind::FUNC_ARG, -1, -1);
+        }
+        int insSub = 0;
+        for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+            const IRBasicBlock *block = func->GetBlock(i);
+            blockFirstValues[i] = operands.size();
+            for (int j = 0 ; j < block->GetArgNum() ; j ++) {
+                AppendValue(pool.FindSymbol(SymbolScope::LOCAL, block->GetArg(j).GetName()), ValueKind::BLOCK_ARG, i, -1);
+            }
+            for (const Ins &ins : block->Instructions()) {
+                // br的目的数位置存放的是条件
+                if (ins.GetDestOp() != -1 && ins.GetInsType() != InsType::BR && ! IsInlineImm(ins.GetDestOp())) {
+                    resultValues[insSub] = AppendValue(ins.GetDestOp(), ValueKind::INS_RESULT, i, insSub);
+                }
+                insSub ++;
+            }
+        }
+        blockFirstValues[func->GetBlockNum()] = operands.size();
+    }
+
+    /**
+     * @brief 获取值数量
+     * 
+     * @return 值数量
+     */
+    const int IRValueNumbering::GetValueNum() const {
+        return operands.size();
+    }
+
+    /**
+     * @brief 获取操作数对应的值
+     * 
+     * @param op 操作数ID
+     * @return 值, 不是本函数中定义的值时为-1
+     */
+    const int IRValueNumbering::GetValue(int op) const {
+        auto iter = valueIndex.find(op);
+        if (iter == valueIndex.end()) {
+            return -1;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 获取值对应的操作数
+     * 
+     * @param value 值
+     * @return 操作数ID
+     */
+    const int IRValueNumbering::GetOperand(int value) const {
+        if (TAYIR_OUT_OF_BOUND(value, (int)operands.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return operands[value];
+    }
+
+    /**
+     * @brief 获取值的种类
+     * 
+     * @param value 值
+     * @return 种类
+     */
+    const ValueKind IRValueNumbering::GetKind(int value) const {
+        if (TAYIR_OUT_OF_BOUND(value, (int)kinds.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return kinds[value];
+    }
+
+    /**
+     * @brief 获取定义值的基本块
+     * 
+     * @param value 值
+     * @return 基本块下标, 函数参数为-1
+     */
+    const int IRValueNumbering::GetDefBlock(int value) const {
+        if (TAYIR_OUT_OF_BOUND(value, (int)defBlocks.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return defBlocks[value];
+    }
+
+    /**
+     * @brief 获取定义值的指令
+     * 
+     * @param value 值
+     * @return 指令在函数中的下标, 参数为-1
+     */
+    const int IRValueNumbering::GetDefIns(int value) const {
+        if (TAYIR_OUT_OF_BOUND(value, (int)defIns.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return defIns[value];
+    }
+
+    /**
+     * @brief 获取指令的结果值
+     * 
+     * @param sub 指令在函数中的下标
+     * @return 值, 指令无结果时为-1
+     */
+    const int IRValueNumbering::GetResultValue(int sub) const {
+        if (TAYIR_OUT_OF_BOUND(sub, (int)resultValues.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return resultValues[sub];
+    }
+
+    /**
+     * @brief 获取基本块定义的值的范围
+     * 
+     * 基本块b定义的值为[GetBlockFirstValue(b), GetBlockFirstValue(b + 1))
+     * 
+     * @param block 基本块下标(可以等于基本块数量)
+     * @return 首个值
+     */
+    const int IRValueNumbering::GetBlockFirstValue(int block) const {
+        if (TAYIR_OUT_OF_BOUND(block, (int)blockFirstValues.size())) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of boundary!";
+        }
+        return blockFirstValues[block];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+/**
+ * @file valuenum.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief SSA值编号
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/operand.h>
+
+#include <vector>
+#include <unordered_map>
+
+namespace tayir {
+    /**
+     * @brief SSA值种类
+     * 
+     * @see IRValueNumbering
+     * 
+     */
+    enum class ValueKind {
+        /** 函数参数 */
+        FUNC_ARG = 0,
+        /** 基本块参数 */
+        BLOCK_ARG = 1,
+        /** 指令结果 */
+        INS_RESULT = 2
+    };
+
+    /**
+     * @brief SSA值编号
+     * 
+     * 为函数中的函数参数, 基本块参数与指令结果分配从0开始的连续编号
+     * 编号顺序为: 函数参数, 然后按基本块顺序依次为块参数与块内指令结果
+     * 数据流分析可以用编号作为位集与数组的下标, 其大小恰为函数中的值数量
+     * 
+     */
+    class IRValueNumbering {
+    protected:
+        /** 值 -> 操作数ID(未在操作数池中出现的参数为-1) */
+        std::vector<int> operands;
+        /** 值 -> 种类 */
+        std::vector<ValueKind> kinds;
+        /** 值 -> 定义所在基本块(函数参数为-1) */
+        std::vector<int> defBlocks;
+        /** 值 -> 定义指令在函数中的下标(参数为-1) */
+        std::vector<int> defIns;
+        /** 操作数ID -> 值 */
+        std::unordered_map<int, int> valueIndex;
+        /** 指令在函数中的下标 -> 结果值(无结果为-1) */
+        std::vector<int> resultValues;
+        /** 基本块 -> 该块首个值 */
+        std::vector<int> blockFirstValues;
+        /**
+         * @brief 追加值
+         * 
+         * @param op 操作数ID
+         * @param kind 种类
+         * @param block 定义所在基本块
+         * @param ins 定义指令在函数中的下标
+         * @return 值
+         */
+        int AppendValue(int op, ValueKind kind, int block, int ins);
+    public:
+        /**
+         * @brief IRValueNumbering构造函数
+         * 
+         * @param func 函数
+         * @param pool 操作数池
+         */
+        IRValueNumbering(const IRFunction *func, const OperandPool &pool);
+        /**
+         * @brief 获取值数量
+         * 
+         * @return 值数量
+         */
+        const int GetValueNum() const;
+        /**
+         * @brief 获取操作数对应的值
+         * 
+         * @param op 操作数ID
+         * @return 值, 不是本函数中定义的值时为-1
+         */
+        const int GetValue(int op) const;
+        /**
+         * @brief 获取值对应的操作数
+         * 
+         * @param value 值
+         * @return 操作数ID
+         */
+        const int GetOperand(int value) const;
+        /**
+         * @brief 获取值的种类
+         * 
+         * @param value 值
+         * @return 种类
+         */
+        const ValueKind GetKind(int value) const;
+        /**
+         * @brief 获取定义值的基本块
+         * 
+         * @param value 值
+         * @return 基本块下标, 函数参数为-1
+         */
+        const int GetDefBlock(int value) const;
+        /**
+         * @brief 获取定义值的指令
+         * 
+         * @param value 值
+         * @return 指令在函数中的下标, 参数为-1
+         */
+        const int GetDefIns(int value) const;
+        /**
+         * @brief 获取指令的结果值
+         * 
+         * @param sub 指令在函数中的下标
+         * @return 值, 指令无结果时为-1
+         */
+        const int GetResultValue(int sub) const;
+        /**
+         * @brief 获取基本块定义的值的范围
+         * 
+         * 基本块b定义的值为[GetBlockFirstValue(b), GetBlockFirstValue(b + 1))
+         * 
+         * @param block 基本块下标(可以等于基本块数量)
+         * @return 首个值
+         */
+        const int GetBlockFirstValue(int block) const;
+    };
+}
\ No newline at end of file
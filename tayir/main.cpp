@@ -1,9 +1,96 @@
 #include <iostream>
+#include <cstring>
 
 void test1();
 void test2();
+void test3();
+void test4();
+void test5();
+void test6();
+void test7();
+void test8();
+void test9();
+void test10();
+void test11();
+void test12();
+void test13();
+void test14();
+void test15();
+void test16();
+void test17(const char *fibPath);
+void test18();
+void test19();
+void test20();
 
 int main(int argc, const char **argv) {
-    test2();
+    if (argc < 2) {
+        test2();
+        return 0;
+    }
+    if (strcmp(argv[1], "test1") == 0) {
+        test1();
+    }
+    else if (strcmp(argv[1], "test2") == 0) {
+        test2();
+    }
+    else if (strcmp(argv[1], "test3") == 0) {
+        test3();
+    }
+    else if (strcmp(argv[1], "test4") == 0) {
+        test4();
+    }
+    else if (strcmp(argv[1], "test5") == 0) {
+        test5();
+    }
+    else if (strcmp(argv[1], "test6") == 0) {
+        test6();
+    }
+    else if (strcmp(argv[1], "test7") == 0) {
+        test7();
+    }
+    else if (strcmp(argv[1], "test8") == 0) {
+        test8();
+    }
+    else if (strcmp(argv[1], "test9") == 0) {
+        test9();
+    }
+    else if (strcmp(argv[1], "test10") == 0) {
+        test10();
+    }
+    else if (strcmp(argv[1], "test11") == 0) {
+        test11();
+    }
+    else if (strcmp(argv[1], "test12") == 0) {
+        test12();
+    }
+    else if (strcmp(argv[1], "test13") == 0) {
+        test13();
+    }
+    else if (strcmp(argv[1], "test14") == 0) {
+        test14();
+    }
+    else if (strcmp(argv[1], "test15") == 0) {
+        test15();
+    }
+    else if (strcmp(argv[1], "test16") == 0) {
+        test16();
+    }
+    else if (strcmp(argv[1], "test17") == 0) {
+        // 可选参数: fib.ir路径
+        test17(argc > 2 ? argv[2] : NULL);
+    }
+    else if (strcmp(argv[1], "test18") == 0) {
+        test18();
+    }
+    else if (strcmp(argv[1], "test19") == 0) {
+        test19();
+    }
+    else if (strcmp(argv[1], "test20") == 0) {
+        test20();
+    }
+    else {
+        std::cerr << "unknown test: " << argv[1] << std::endl;
+        return 1;
+    }
     return 0;
 }
\ No newline at end of file
@@ -1,2 +1,20 @@
 objects += ./tests/test1.o
-objects += ./tests/test2.o
\ No newline at end of file
+objects += ./tests/test2.o
+objects += ./tests/test3.o
+objects += ./tests/test4.o
+objects += ./tests/test5.o
+objects += ./tests/test6.o
+objects += ./tests/test7.o
+objects += ./tests/test8.o
+objects += ./tests/test9.o
+objects += ./tests/test10.o
+objects += ./tests/test11.o
+objects += ./tests/test12.o
+objects += ./tests/test13.o
+objects += ./tests/test14.o
+objects += ./tests/test15.o
+objects += ./tests/test16.o
+objects += ./tests/test17.o
+objects += ./tests/test18.o
+objects += ./tests/test19.o
+objects += ./tests/test20.o
\ No newline at end of file
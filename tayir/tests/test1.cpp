@@ -88,4 +88,24 @@ void test1() {
     std::cout << offsetof(myType2, ui8_7) << ":" << myType2Type->GetMemberOffset(6) << std::endl;
     std::cout << "total size:" << std::endl;
     std::cout << sizeof(myType2) << ":" << myType2Type->GetSize() << std::endl;
+
+    int myTypeAliasId = manager.AppendType(
+        ComplexTypeBuilder()
+            .AppendType(manager.GetUI8Id())
+            .AppendType(manager.GetI32Id())
+            .AppendType(manager.GetUI32Id())
+            .AppendType(manager.GetI64Id())
+            .AppendType(manager.GetUI8Id())
+            .AppendType(manager.GetI32Id())
+            .AppendType(manager.GetUI8Id())
+            .AppendType(manager.GetI32Id())
+            .AppendType(manager.GetUI64Id())
+            .AppendType(manager.GetBoolId())
+            .Build("myTypeAlias", 3, manager)
+    );
+
+    std::cout << "structural uniquing:" << std::endl;
+    std::cout << myTypeId << ":" << myTypeAliasId << std::endl;
+    std::cout << myTypeId << ":" << manager.GetTypeId("myTypeAlias") << std::endl;
+    std::cout << myType2Id << ":" << manager.GetTypeId("myType2") << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/status.h>
+#include <iostream>
+
+using namespace tayir;
+
+static IRFunctionBuilder &AppendJump(IRFunctionBuilder &builder, const char *name, int target) {
+    return builder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::GOTO, -1, target))
+            .Build(name)
+    );
+}
+
+void test10() {
+    OperandPool pool;
+    int LabelA = pool.GetOrAddLabel("a");
+    int LabelB = pool.GetOrAddLabel("b");
+    int LabelC = pool.GetOrAddLabel("c");
+    IRFunction *func;
+
+    IRFunctionBuilder good;
+    good.GetDecl().name = "good";
+    AppendJump(good, "a", LabelB);
+    AppendJump(good, "b", LabelA);
+    std::cout << "good: " << ToString(good.TryBuild(pool, func)) << ", " << func->GetBlockNum() << " blocks" << std::endl;
+    delete func;
+
+    IRFunctionBuilder duplicate;
+    AppendJump(duplicate, "a", LabelA);
+    AppendJump(duplicate, "a", LabelA);
+    std::cout << "duplicate: " << ToString(duplicate.TryBuild(pool, func)) << ", " << (func == NULL ? "no function" : "function!") << std::endl;
+
+    IRFunctionBuilder unresolved;
+    AppendJump(unresolved, "a", LabelC);
+    std::cout << "unresolved: " << ToString(unresolved.TryBuild(pool, func)) << ", " << unresolved.GetBlockNum() << " blocks kept" << std::endl;
+
+    IRBasicBlock *extra = IRBasicBlockBuilder().Build("extra");
+    std::cout << "replace: " << ToString(unresolved.TryReplaceBlock(5, extra)) << std::endl;
+    std::cout << "replace: " << ToString(unresolved.TryReplaceBlock(0, extra)) << std::endl;
+    std::cout << "rebuild: " << ToString(unresolved.TryBuild(pool, func)) << std::endl;
+    delete func;
+
+    // 跳转位置不是标号操作数
+    OperandPool arenaPool(OperandPoolMode::ARENA);
+    arenaPool.GetOrAddLabel("a");
+    const int notLabels[] = {
+        arenaPool.GetOrAddSymbol(SymbolScope::LOCAL, "a"), MakeInlineImm(0), MakeArgSpan(0, 1), 1000
+    };
+    for (int target : notLabels) {
+        IRFunctionBuilder bad;
+        AppendJump(bad, "a", target);
+        std::cout << "not a label: " << ToString(bad.TryBuild(arenaPool, func)) << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/operand.h>
+#include <chrono>
+#include <iostream>
+
+using namespace tayir;
+
+static const int DISPATCH_OPERAND_NUM = 1000000;
+static const int DISPATCH_BLOCK_NUM = 1000;
+static const int DISPATCH_BLOCK_INS_NUM = 1000;
+
+// 不借助访问器时检查具体操作数类型的写法
+static long long InspectByCast(OperandBase *operand) {
+    if (ImmediateOperand *imm = dynamic_cast<ImmediateOperand *>(operand)) {
+        return imm->GetValue().i32Val;
+    }
+    if (SymbolOperand *symbol = dynamic_cast<SymbolOperand *>(operand)) {
+        return symbol->GetName().GetId();
+    }
+    if (LabelOperand *label = dynamic_cast<LabelOperand *>(operand)) {
+        return label->GetName().GetId();
+    }
+    if (ArgListOperand *argList = dynamic_cast<ArgListOperand *>(operand)) {
+        return argList->GetArgNum();
+    }
+    return 0;
+}
+
+// 以虚函数取值的操作数, 作为每个操作数一次普通虚调用的基线
+struct VirtualOperand {
+    virtual ~VirtualOperand() {}
+    virtual long long Inspect() const = 0;
+};
+
+struct VirtualImmediate final : VirtualOperand {
+    const ImmediateOperand &operand;
+    VirtualImmediate(const ImmediateOperand &operand) : operand(operand) {}
+    virtual long long Inspect() const override { return operand.GetValue().i32Val; }
+};
+
+struct VirtualSymbol final : VirtualOperand {
+    const SymbolOperand &operand;
+    VirtualSymbol(const SymbolOperand &operand) : operand(operand) {}
+    virtual long long Inspect() const override { return operand.GetName().GetId(); }
+};
+
+struct VirtualLabel final : VirtualOperand {
+    const LabelOperand &operand;
+    VirtualLabel(const LabelOperand &operand) : operand(operand) {}
+    virtual long long Inspect() const override { return operand.GetName().GetId(); }
+};
+
+struct VirtualArgList final : VirtualOperand {
+    const ArgListOperand &operand;
+    VirtualArgList(const ArgListOperand &operand) : operand(operand) {}
+    virtual long long Inspect() const override { return operand.GetArgNum(); }
+};
+
+struct VirtualEmpty final : VirtualOperand {
+    virtual long long Inspect() const override { return 0; }
+};
+
+struct MakeVirtual {
+    VirtualOperand *operator()(const ImmediateOperand &imm) const { return new VirtualImmediate(imm); }
+    VirtualOperand *operator()(const SymbolOperand &symbol) const { return new VirtualSymbol(symbol); }
+    VirtualOperand *operator()(const LabelOperand &label) const { return new VirtualLabel(label); }
+    VirtualOperand *operator()(const ArgListOperand &argList) const { return new VirtualArgList(argList); }
+    VirtualOperand *operator()(const EmptyOperand &) const { return new VirtualEmpty(); }
+};
+
+struct InspectVisitor {
+    long long operator()(const ImmediateOperand &imm) const {
+        return imm.GetValue().i32Val;
+    }
+    long long operator()(const SymbolOperand &symbol) const {
+        return symbol.GetName().GetId();
+    }
+    long long operator()(const LabelOperand &label) const {
+        return label.GetName().GetId();
+    }
+    long long operator()(const ArgListOperand &argList) const {
+        return argList.GetArgNum();
+    }
+    long long operator()(const EmptyOperand &) const {
+        return 0;
+    }
+};
+
+template<typename Slice> static long long SumSrc2(const IRStaticSlice<Slice> &slice) {
+    long long sum = 0;
+    slice.ForEachIns([&sum](const Ins &ins) {
+        sum += ins.GetSrc2Op();
+    });
+    return sum;
+}
+
+void test11() {
+    OperandPool pool;
+    std::vector<int> ids;
+    for (int i = 0 ; i < DISPATCH_OPERAND_NUM ; i ++) {
+        switch (i % 4) {
+        case 0: ids.push_back(pool.AppendImmediate(imm::itype::I32, ImmediateValue{.i32Val = i})); break;
+        case 1: ids.push_back(pool.AppendSymbol(SymbolScope::LOCAL, "v" + std::to_string(i % 1000))); break;
+        case 2: ids.push_back(pool.AppendLabel("l" + std::to_string(i % 1000))); break;
+        case 3: ids.push_back(pool.AppendArgList({ids[i - 1]})); break;
+        }
+    }
+
+    std::vector<OperandBase *> operands;
+    std::vector<VirtualOperand *> virtualOperands;
+    for (int id : ids) {
+        operands.push_back(pool.GetOperand(id));
+        virtualOperands.push_back(VisitOperand((const OperandBase *)operands.back(), MakeVirtual()));
+    }
+
+    long long sumVirtualCall = 0, sumCast = 0, sumVisit = 0;
+    size_t lenVirtual = 0, lenVisit = 0;
+    auto tv = std::chrono::steady_clock::now();
+    for (VirtualOperand *operand : virtualOperands) {
+        sumVirtualCall += operand->Inspect();
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (OperandBase *operand : operands) {
+        sumCast += InspectByCast(operand);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (OperandBase *operand : operands) {
+        sumVisit += VisitOperand(operand, InspectVisitor());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    // 以下两项都以字符串格式化为主, 仅用于核对结果, 分派开销看上面三项
+    for (int id : ids) {
+        OperandBase *operand = pool.GetOperand(id);
+        lenVirtual += operand->ToString(pool).size();
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    for (int id : ids) {
+        lenVisit += pool.ToString(id).size();
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    std::cout << "per million operands:" << std::endl;
+    std::cout << "inspect, virtual call:  " << std::chrono::duration<double, std::milli>(t0 - tv).count() << " ms" << std::endl;
+    std::cout << "inspect, dynamic_cast:  " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "inspect, VisitOperand:  " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "print, virtual:         " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms" << std::endl;
+    std::cout << "print, VisitOperand:    " << std::chrono::duration<double, std::milli>(t4 - t3).count() << " ms" << std::endl;
+    std::cout << ((sumVirtualCall == sumVisit && sumCast == sumVisit && lenVirtual == lenVisit) ? "result match" : "result mismatch!") << std::endl;
+    for (VirtualOperand *operand : virtualOperands) {
+        delete operand;
+    }
+
+    IRFunctionBuilder fnBuilder;
+    fnBuilder.GetDecl().name = "dispatch";
+    for (int i = 0 ; i < DISPATCH_BLOCK_NUM ; i ++) {
+        IRBasicBlockBuilder blockBuilder;
+        blockBuilder.Reserve(DISPATCH_BLOCK_INS_NUM);
+        for (int j = 0 ; j < DISPATCH_BLOCK_INS_NUM ; j ++) {
+            blockBuilder.AppendIns(Ins(InsType::ADD, ids[1], ids[1], j));
+        }
+        fnBuilder.AppendBlock(blockBuilder.Build("b" + std::to_string(i)));
+    }
+    IRFunction *func = fnBuilder.Build();
+
+    long long sumVirtual = 0, sumStatic = 0;
+    auto t5 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+        const IRSlice &slice = *func->GetBlock(i);
+        for (int j = 0 ; j < slice.GetInsNum() ; j ++) {
+            sumVirtual += slice.GetIns(j).GetSrc2Op();
+        }
+    }
+    auto t6 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+        sumStatic += SumSrc2(*func->GetBlock(i));
+    }
+    auto t7 = std::chrono::steady_clock::now();
+
+    std::cout << "per million instructions:" << std::endl;
+    std::cout << "virtual GetIns:         " << std::chrono::duration<double, std::milli>(t6 - t5).count() << " ms" << std::endl;
+    std::cout << "IRStaticSlice:          " << std::chrono::duration<double, std::milli>(t7 - t6).count() << " ms" << std::endl;
+    std::cout << (sumVirtual == sumStatic ? "result match" : "result mismatch!") << std::endl;
+    std::cout << "add count: " << func->CountIns(InsType::ADD) << std::endl;
+    delete func;
+}
\ No newline at end of file
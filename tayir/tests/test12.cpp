@@ -0,0 +1,111 @@
+#include <utils/buffer.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace tayir;
+
+static const int BENCH_BYTES = 64 * 1024 * 1024;
+static const int BENCH_ROUNDS = 8;
+
+static bool CheckByteOrder() {
+    ByteBuffer little(64);
+    BigByteBuffer big(64);
+    little.WriteDword(0x01020304);
+    big.WriteDword(0x01020304);
+    little.WriteShort(-2);
+    big.WriteLongLong(-3);
+    byte littleBytes[4], bigBytes[4];
+    little.ReadBytes(littleBytes, 4);
+    big.ReadBytes(bigBytes, 4);
+    if (littleBytes[0] != 0x04 || littleBytes[3] != 0x01 || bigBytes[0] != 0x01 || bigBytes[3] != 0x04) {
+        return false;
+    }
+    if (little.ReadShort() != -2 || big.ReadLongLong() != -3) {
+        return false;
+    }
+
+    const qword vals[] = {0x0102030405060708ull, 0xFFEEDDCCBBAA9988ull, 42};
+    qword littleVals[3], bigVals[3];
+    little.Reset();
+    big.Reset();
+    little.WriteQwords(Span<const qword>(vals, 3));
+    big.WriteQwords(Span<const qword>(vals, 3));
+    if (big.ReadByte() != 0x01) {
+        return false;
+    }
+    big.Reset();
+    big.WriteQwords(Span<const qword>(vals, 3));
+    little.ReadQwords(Span<qword>(littleVals, 3));
+    big.ReadQwords(Span<qword>(bigVals, 3));
+    for (int i = 0 ; i < 3 ; i ++) {
+        if (littleVals[i] != vals[i] || bigVals[i] != vals[i]) {
+            return false;
+        }
+    }
+    try {
+        big.ReadDword();
+        return false;
+    }
+    catch (const char *) {
+    }
+    return true;
+}
+
+template<typename Fn> static double MeasureGBps(Fn &&fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < BENCH_ROUNDS ; i ++) {
+        fn();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return (double)BENCH_BYTES * BENCH_ROUNDS / std::chrono::duration<double>(t1 - t0).count() / 1e9;
+}
+
+template<ByteOrder Order> static void Bench(const char *name, const std::vector<qword> &vals) {
+    BasicByteBuffer<Order> buffer(BENCH_BYTES);
+    std::vector<qword> back(vals.size());
+    const int num = vals.size();
+
+    double bytewise = MeasureGBps([&]() {
+        buffer.Reset();
+        for (int i = 0 ; i < num ; i ++) {
+            for (int j = 0 ; j < 8 ; j ++) {
+                const int shift = Order == ByteOrder::BIG ? 56 - j * 8 : j * 8;
+                buffer.WriteByte((vals[i] >> shift) & 0xFF);
+            }
+        }
+    });
+    double scalar = MeasureGBps([&]() {
+        buffer.Reset();
+        for (int i = 0 ; i < num ; i ++) {
+            buffer.WriteQword(vals[i]);
+        }
+    });
+    double array = MeasureGBps([&]() {
+        buffer.Reset();
+        buffer.WriteQwords(Span<const qword>(vals.data(), vals.size()));
+    });
+    double read = MeasureGBps([&]() {
+        buffer.Reset();
+        buffer.WriteQwords(Span<const qword>(vals.data(), vals.size()));
+        buffer.ReadQwords(Span<qword>(back.data(), back.size()));
+    });
+    std::cout << name << ": byte-by-byte " << bytewise << " GB/s, WriteQword " << scalar
+              << " GB/s, WriteQwords " << array << " GB/s, write+ReadQwords " << read << " GB/s"
+              << (back == vals ? "" : " (MISMATCH)") << std::endl;
+}
+
+void test12() {
+    std::cout << "byte order: " << (CheckByteOrder() ? "ok" : "FAILED") << std::endl;
+
+    std::vector<qword> vals(BENCH_BYTES / sizeof(qword));
+    qword x = 88172645463325252ull;
+    for (qword &val : vals) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        val = x;
+    }
+    Bench<ByteOrder::LITTLE>("little", vals);
+    Bench<ByteOrder::BIG>("big", vals);
+}
@@ -0,0 +1,86 @@
+#include <utils/buffer.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace tayir;
+
+static const int BENCH_BYTES = 256 * 1024 * 1024;
+static const int BENCH_CHUNK = 512;
+
+static bool CheckGrowth(BufferStorage storage, Arena *arena) {
+    ByteBuffer buffer(1, storage, arena);
+    for (int i = 0 ; i < 100000 ; i ++) {
+        buffer.WriteDword(i);
+    }
+    if (buffer.GetWritePos() != 400000 || buffer.GetCapacity() < 400000) {
+        return false;
+    }
+    if (storage != BufferStorage::HEAP && (size_t)buffer.GetData() % BUFFER_ALIGN != 0) {
+        return false;
+    }
+    for (int i = 0 ; i < 100000 ; i ++) {
+        if (buffer.ReadDword() != (dword)i) {
+            return false;
+        }
+    }
+    // 直接写入占用的空间
+    byte *dst = buffer.Claim(3);
+    dst[0] = 'a';
+    dst[1] = 'b';
+    dst[2] = 'c';
+    return buffer.ReadChar() == 'a' && buffer.GetData()[buffer.GetWritePos() - 1] == 'c';
+}
+
+// 缓存是Arena最近一次分配时原地扩容; 之后有其他分配时改为复制, 内容不变
+static bool CheckArenaGrowth() {
+    Arena arena;
+    ByteBuffer buffer(1, BufferStorage::ARENA, &arena);
+    for (int i = 0 ; i < 100000 ; i ++) {
+        buffer.WriteDword(i);
+    }
+    const bool inPlace = arena.GetChunkNum() == 1 && arena.GetReservedBytes() < (size_t)buffer.GetCapacity() + 2 * BUFFER_ALIGN + 64;
+    arena.Allocate(16);
+    for (int i = 100000 ; i < 200000 ; i ++) {
+        buffer.WriteDword(i);
+    }
+    for (int i = 0 ; i < 200000 ; i ++) {
+        if (buffer.ReadDword() != (dword)i) {
+            return false;
+        }
+    }
+    return inPlace && arena.GetChunkNum() == 2 && (size_t)buffer.GetData() % BUFFER_ALIGN == 0;
+}
+
+static double BenchStorage(BufferStorage storage, Arena *arena, bool reserve, const std::vector<qword> &chunk) {
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        ByteBuffer buffer(4096, storage, arena);
+        if (reserve) {
+            buffer.Reserve(BENCH_BYTES);
+        }
+        for (int i = 0 ; i < BENCH_BYTES / (BENCH_CHUNK * (int)sizeof(qword)) ; i ++) {
+            buffer.WriteQwords(Span<const qword>(chunk.data(), chunk.size()));
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return (double)BENCH_BYTES / std::chrono::duration<double>(t1 - t0).count() / 1e9;
+}
+
+void test13() {
+    Arena arena;
+    const BufferStorage storages[] = {BufferStorage::HEAP, BufferStorage::ALIGNED, BufferStorage::HUGE_PAGE, BufferStorage::ARENA};
+    const char *names[] = {"heap", "aligned", "huge page", "arena"};
+
+    std::vector<qword> chunk(BENCH_CHUNK);
+    for (int i = 0 ; i < BENCH_CHUNK ; i ++) {
+        chunk[i] = (qword)i * 0x9E3779B97F4A7C15ull;
+    }
+    for (int i = 0 ; i < 4 ; i ++) {
+        std::cout << names[i] << ": growth " << (CheckGrowth(storages[i], &arena) ? "ok" : "FAILED")
+                  << ", grown " << BenchStorage(storages[i], &arena, false, chunk) << " GB/s"
+                  << ", reserved " << BenchStorage(storages[i], &arena, true, chunk) << " GB/s" << std::endl;
+    }
+    std::cout << "arena in-place growth: " << (CheckArenaGrowth() ? "ok" : "FAILED") << std::endl;
+    std::cout << "arena reserved: " << arena.GetReservedBytes() / (1024 * 1024) << " MB" << std::endl;
+}
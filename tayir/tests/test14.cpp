@@ -0,0 +1,104 @@
+#include <utils/buffer.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace tayir;
+
+static const int BENCH_VALUES = 8 * 1024 * 1024;
+
+static bool CheckVarint() {
+    const qword edges[] = {0, 1, 127, 128, 16383, 16384, (1ull << 56) - 1, 1ull << 56, 0xFFFFFFFFFFFFFFFFull};
+    const long long signedEdges[] = {0, -1, 1, -64, 64, -0x7FFFFFFFFFFFFFFFll - 1, 0x7FFFFFFFFFFFFFFFll};
+    ByteBuffer buffer(16);
+    for (qword val : edges) {
+        buffer.WriteVarU(val);
+    }
+    for (long long val : signedEdges) {
+        buffer.WriteVarS(val);
+    }
+    // 补足字节使批量解码走快速路径
+    for (int i = 0 ; i < 40 ; i ++) {
+        buffer.WriteVarU(i);
+    }
+    if (buffer.GetWritePos() != 1 + 1 + 1 + 2 + 2 + 3 + 8 + 9 + 10 + 1 + 1 + 1 + 1 + 2 + 10 + 10 + 40) {
+        return false;
+    }
+    for (qword val : edges) {
+        if (buffer.ReadVarU() != val) {
+            return false;
+        }
+    }
+    for (long long val : signedEdges) {
+        if (buffer.ReadVarS() != val) {
+            return false;
+        }
+    }
+
+    buffer.Reset();
+    std::vector<qword> vals;
+    for (int i = 0 ; i < 1000 ; i ++) {
+        vals.push_back(i % 7 == 0 ? (qword)i << (i % 60) : i % 100);
+        buffer.WriteVarU(vals.back());
+    }
+    std::vector<qword> batch(vals.size());
+    buffer.ReadVarUs(Span<qword>(batch.data(), batch.size()));
+    if (batch != vals || buffer.GetReadPos() != buffer.GetWritePos()) {
+        return false;
+    }
+
+    // 截断的整数不移动读指针
+    buffer.Reset();
+    buffer.WriteByte(0x80);
+    try {
+        buffer.ReadVarUs(Span<qword>(batch.data(), 1));
+        return false;
+    }
+    catch (const char *) {
+    }
+    return buffer.GetReadPos() == 0;
+}
+
+void test14() {
+    std::cout << "varint: " << (CheckVarint() ? "ok" : "FAILED") << std::endl;
+
+    // 模拟操作数ID与小常量: 大部分小于128, 少量较大
+    std::vector<qword> vals(BENCH_VALUES);
+    unsigned int x = 12345;
+    for (qword &val : vals) {
+        x = x * 1103515245 + 12345;
+        const unsigned int r = x >> 8;
+        val = (r % 10 < 8) ? r % 128 : (r % 10 == 8 ? r % 16384 : r);
+    }
+
+    ByteBuffer fixed(BENCH_VALUES * sizeof(dword));
+    ByteBuffer varint(BENCH_VALUES);
+    auto t0 = std::chrono::steady_clock::now();
+    for (qword val : vals) {
+        fixed.WriteDword(val);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (qword val : vals) {
+        varint.WriteVarU(val);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    std::vector<qword> scalar(BENCH_VALUES), batch(BENCH_VALUES);
+    auto t3 = std::chrono::steady_clock::now();
+    for (qword &val : scalar) {
+        val = varint.ReadVarU();
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    varint.Rewind();
+    varint.ReadVarUs(Span<qword>(batch.data(), batch.size()));
+    auto t5 = std::chrono::steady_clock::now();
+
+    auto toMs = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    std::cout << BENCH_VALUES << " values: dword " << fixed.GetWritePos() << " bytes, varint " << varint.GetWritePos()
+              << " bytes (" << (double)fixed.GetWritePos() / varint.GetWritePos() << "x smaller)" << std::endl;
+    std::cout << "write: dword " << toMs(t1 - t0) << " ms, varint " << toMs(t2 - t1) << " ms" << std::endl;
+    std::cout << "read: ReadVarU " << toMs(t4 - t3) << " ms, ReadVarUs " << toMs(t5 - t4) << " ms"
+              << (scalar == vals && batch == vals ? "" : " (MISMATCH)") << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/module.h>
+#include <ir/bytecode.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using namespace tayir;
+
+static const int BENCH_FUNC_NUM = 2000;
+static const int BENCH_ROUND_NUM = 10;
+
+static IRModule *BuildFibModule() {
+    IRModule *module = new IRModule("fib");
+    OperandPool &opPool = module->GetOperandPool();
+    TypeManager &man = module->GetTypeManager();
+
+    int FuncFib     = opPool.GetOrAddSymbol(SymbolScope::GLOBAL, "fib");
+    int ValN        = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValTmpCond0 = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$cond$0");
+    int ValTmpCond1 = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$cond$1");
+    int ValTmpRet0  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$ret$0");
+    int ValTmpRet1  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$ret$1");
+    int ValTmpRes0  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$0");
+    int ValTmpRes1  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$1");
+    int ValTmpRes2  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$2");
+    int LabelIf0    = opPool.GetOrAddLabel("if0");
+    int LabelElse0  = opPool.GetOrAddLabel("else0");
+    int LabelElse1  = opPool.GetOrAddLabel("else1");
+    int Const0      = opPool.GetOrAddInt(0);
+    int Const1      = opPool.GetOrAddInt(1);
+    int Const2      = opPool.GetOrAddInt(2);
+    ImmediateValue big;
+    big.i64Val = 1ll << 40;
+    opPool.GetOrAddImmediate(imm::itype::I64, big);
+
+    IRFunctionBuilder fnBuilder;
+    int ArgComp1    = fnBuilder.AppendCallArgs({ValTmpRes0});
+    int ArgComp2    = fnBuilder.AppendCallArgs({ValTmpRes1});
+    fnBuilder.GetDecl().name = "fib";
+    fnBuilder.GetDecl().conventionId = 0;
+    fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+    fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::EQU, ValTmpCond0, ValN, Const0))
+            .AppendIns(Ins(InsType::BR,  ValTmpCond0, LabelIf0, LabelElse0))
+            .Build("start")
+    );
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::EQU, ValTmpCond1, ValN, Const1))
+            .AppendIns(Ins(InsType::BR,  ValTmpCond1, LabelIf0, LabelElse1))
+            .Build("else0")
+    );
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::RET,          -1, Const1))
+            .Build("if0")
+    );
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::SUB,  ValTmpRes0, ValN, Const1))
+            .AppendIns(Ins(InsType::SUB,  ValTmpRes1, ValN, Const2))
+            .AppendIns(Ins(InsType::CALL, ValTmpRet0, FuncFib, ArgComp1))
+            .AppendIns(Ins(InsType::CALL, ValTmpRet1, FuncFib, ArgComp2))
+            .AppendIns(Ins(InsType::ADD,  ValTmpRes2, ValTmpRet0, ValTmpRet1))
+            .AppendIns(Ins(InsType::RET,          -1, ValTmpRes2))
+            .Build("else1")
+    );
+    module->AppendFunction(fnBuilder.Build(opPool));
+
+    IRFuncDecl print;
+    print.name = "print";
+    print.conventionId = 0;
+    print.returnTypeId = man.GetI32Id();
+    print.args.push_back(Argument(man.GetI64Id(), "value"));
+    module->GetFuncDeclTab().AppendFuncDecl(print);
+    man.AppendType(ComplexTypeBuilder().AppendType(man.GetI32Id()).AppendType(man.GetI64Id()).Build("pair", 3, man));
+    return module;
+}
+
+static IRModule *BuildBenchModule() {
+    IRModule *module = new IRModule("bench");
+    OperandPool &pool = module->GetOperandPool();
+    TypeManager &man = module->GetTypeManager();
+    int ValN = pool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValCond = pool.GetOrAddSymbol(SymbolScope::LOCAL, "cond");
+    int LabelLoop = pool.GetOrAddLabel("loop");
+    int LabelExit = pool.GetOrAddLabel("exit");
+
+    for (int i = 0 ; i < BENCH_FUNC_NUM ; i ++) {
+        IRFunctionBuilder fnBuilder;
+        fnBuilder.GetDecl().name = "f" + std::to_string(i);
+        fnBuilder.GetDecl().conventionId = 0;
+        fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+        fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+        IRBasicBlockBuilder loop;
+        loop.Reserve(64);
+        for (int j = 0 ; j < 62 ; j ++) {
+            loop.AppendIns(Ins(InsType::ADD, ValN, ValN, pool.GetOrAddInt(i * 64 + j)));
+        }
+        loop.AppendIns(Ins(InsType::LT, ValCond, ValN, pool.GetOrAddInt(i)));
+        loop.AppendIns(Ins(InsType::BR, ValCond, LabelLoop, LabelExit));
+        fnBuilder.AppendBlock(loop.Build("loop"));
+        fnBuilder.AppendBlock(
+            IRBasicBlockBuilder()
+                .AppendIns(Ins(InsType::RET, -1, ValN))
+                .Build("exit")
+        );
+        module->AppendFunction(fnBuilder.Build(pool));
+    }
+    return module;
+}
+
+static std::string ToText(IRModule &module) {
+    std::ostringstream outs;
+    module.PrintRawString(outs);
+    return outs.str();
+}
+
+void test15() {
+    IRModule *fib = BuildFibModule();
+    ByteBuffer buffer(256);
+    WriteModule(*fib, buffer);
+    IRModule *loaded = LoadModule(buffer);
+    const std::string text = ToText(*fib);
+    std::cout << ToText(*loaded);
+    std::cout << "fib: " << buffer.GetWritePos() << " bytes, round trip " << (ToText(*loaded) == text ? "ok" : "FAILED")
+              << ", pool " << loaded->GetOperandPool().GetOperandNum() << "/" << fib->GetOperandPool().GetOperandNum()
+              << ", decls " << loaded->GetFuncDeclTab().GetFuncDeclNum()
+              << ", pair " << (loaded->GetTypeManager().GetTypeId("pair") == fib->GetTypeManager().GetTypeId("pair") ? "ok" : "FAILED")
+              << std::endl;
+    delete loaded;
+
+    WriteModuleFile(*fib, "/tmp/tayir_fib.tbc");
+    loaded = LoadModuleFile("/tmp/tayir_fib.tbc");
+    std::cout << "file round trip " << (ToText(*loaded) == text ? "ok" : "FAILED") << std::endl;
+    delete loaded;
+
+    // 截断的模块应当报错
+    ByteBuffer truncated(buffer.GetWritePos());
+    truncated.WriteBytes(buffer.GetData(), buffer.GetWritePos() - 3);
+    try {
+        delete LoadModule(truncated);
+        std::cout << "truncated: FAILED" << std::endl;
+    }
+    catch (const char *msg) {
+        std::cout << "truncated: " << msg << std::endl;
+    }
+    delete fib;
+
+    IRModule *bench = BuildBenchModule();
+    ByteBuffer image(1024 * 1024);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < BENCH_ROUND_NUM ; i ++) {
+        image.Reset();
+        WriteModule(*bench, image);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < BENCH_ROUND_NUM ; i ++) {
+        image.Rewind();
+        delete LoadModule(image);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    size_t textBytes = 0;
+    for (int i = 0 ; i < BENCH_ROUND_NUM ; i ++) {
+        textBytes = ToText(*bench).size();
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    auto toMs = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count() / BENCH_ROUND_NUM;
+    };
+    const double mb = image.GetWritePos() / (1024.0 * 1024.0);
+    std::cout << BENCH_FUNC_NUM << " functions: tbc " << image.GetWritePos() << " bytes, text " << textBytes << " bytes" << std::endl;
+    std::cout << "write: " << toMs(t1 - t0) << " ms (" << mb / toMs(t1 - t0) * 1000 << " MB/s)" << std::endl;
+    std::cout << "load: " << toMs(t2 - t1) << " ms (" << mb / toMs(t2 - t1) * 1000 << " MB/s, "
+              << BENCH_FUNC_NUM / toMs(t2 - t1) * 1000 << " functions/s)" << std::endl;
+    std::cout << "print text: " << toMs(t3 - t2) << " ms" << std::endl;
+    delete bench;
+
+    // 结构相同的类型共用ID, 别名须随模块保存
+    IRModule typed("typed");
+    TypeManager &typedMan = typed.GetTypeManager();
+    for (const char *name : {"Point", "Size"}) {
+        typedMan.AppendType(ComplexTypeBuilder().AppendType(typedMan.GetI32Id()).AppendType(typedMan.GetI32Id()).Build(name, 2, typedMan));
+    }
+    ByteBuffer typedImage(256);
+    WriteModule(typed, typedImage);
+    IRModule *typedLoaded = LoadModule(typedImage);
+    std::cout << "alias: Size " << typedMan.GetTypeId("Size") << " -> " << typedLoaded->GetTypeManager().GetTypeId("Size") << std::endl;
+    delete typedLoaded;
+
+    // 外部函数声明的写出顺序与加入顺序无关
+    IRModule forward("externs"), backward("externs");
+    for (int i = 0 ; i < 50 ; i ++) {
+        IRFuncDecl decl;
+        decl.name = "ext" + std::to_string(i);
+        decl.conventionId = 0;
+        decl.returnTypeId = -1;
+        forward.GetFuncDeclTab().AppendFuncDecl(decl);
+        decl.name = "ext" + std::to_string(49 - i);
+        backward.GetFuncDeclTab().AppendFuncDecl(decl);
+    }
+    ByteBuffer forwardImage(256), backwardImage(256);
+    WriteModule(forward, forwardImage);
+    WriteModule(backward, backwardImage);
+    const bool sameBytes = forwardImage.GetWritePos() == backwardImage.GetWritePos()
+        && memcmp(forwardImage.GetData(), backwardImage.GetData(), forwardImage.GetWritePos()) == 0;
+    std::cout << "extern order: " << (sameBytes ? "same bytes" : "DIFFERS") << std::endl;
+
+    // 类型ID越界的函数声明
+    IRModule badTyped("bad");
+    IRFunctionBuilder badBuilder;
+    badBuilder.GetDecl().name = "bad";
+    badBuilder.GetDecl().conventionId = 0;
+    badBuilder.GetDecl().returnTypeId = 9999;
+    badTyped.GetFuncDeclTab().AppendFuncDecl(badBuilder.GetDecl());
+    ByteBuffer badImage(256);
+    WriteModule(badTyped, badImage);
+    try {
+        delete LoadModule(badImage);
+        std::cout << "bad return type: not rejected" << std::endl;
+    }
+    catch (const char *msg) {
+        std::cout << "bad return type: " << msg << std::endl;
+    }
+}
@@ -0,0 +1,143 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/module.h>
+#include <ir/bytecode.h>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace tayir;
+
+static const int BENCH_FUNC_NUM = 20000;
+static const int BENCH_USED_NUM = 10;
+static const char *BENCH_PATH = "/tmp/tayir_lazy.tbc";
+
+static void WriteBenchModule() {
+    IRModule module("lazy");
+    OperandPool &pool = module.GetOperandPool();
+    TypeManager &man = module.GetTypeManager();
+    int LabelLoop = pool.GetOrAddLabel("loop");
+    int LabelExit = pool.GetOrAddLabel("exit");
+
+    // 每个函数有自己的符号与超出内联范围的立即数, 操作数池随函数数增长
+    for (int i = 0 ; i < BENCH_FUNC_NUM ; i ++) {
+        int ValN = pool.GetOrAddSymbol(SymbolScope::LOCAL, "n" + std::to_string(i));
+        int ValCond = pool.GetOrAddSymbol(SymbolScope::LOCAL, "cond" + std::to_string(i));
+        int FuncNext = pool.GetOrAddSymbol(SymbolScope::GLOBAL, "next" + std::to_string(i));
+        IRFunctionBuilder fnBuilder;
+        fnBuilder.GetDecl().name = "f" + std::to_string(i);
+        fnBuilder.GetDecl().conventionId = 0;
+        fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+        fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+        IRBasicBlockBuilder loop;
+        loop.Reserve(64);
+        for (int j = 0 ; j < 61 ; j ++) {
+            ImmediateValue value;
+            value.i64Val = (1ll << 40) + i * 64 + j;
+            loop.AppendIns(Ins(InsType::ADD, ValN, ValN, pool.GetOrAddImmediate(imm::itype::I64, value)));
+        }
+        loop.AppendIns(Ins(InsType::CALL, ValN, FuncNext, fnBuilder.AppendCallArgs({ValN, pool.GetOrAddInt(i)})));
+        loop.AppendIns(Ins(InsType::LT, ValCond, ValN, pool.GetOrAddInt(i)));
+        loop.AppendIns(Ins(InsType::BR, ValCond, LabelLoop, LabelExit));
+        fnBuilder.AppendBlock(loop.Build("loop"));
+        fnBuilder.AppendBlock(
+            IRBasicBlockBuilder()
+                .AppendIns(Ins(InsType::RET, -1, ValN))
+                .Build("exit")
+        );
+        module.AppendFunction(fnBuilder.Build(pool));
+
+        IRFuncDecl next;
+        next.name = "next" + std::to_string(i);
+        next.conventionId = 0;
+        next.returnTypeId = man.GetI32Id();
+        next.args.push_back(Argument(man.GetI32Id(), "n"));
+        next.args.push_back(Argument(man.GetI32Id(), "i"));
+        module.GetFuncDeclTab().AppendFuncDecl(std::move(next));
+    }
+    WriteModuleFile(module, BENCH_PATH);
+    std::cout << "module: " << BENCH_FUNC_NUM << " functions, " << pool.GetOperandNum() << " operands" << std::endl;
+}
+
+static double GetRssMB(bool anonymousOnly) {
+    long pages = 0, resident = 0, shared = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (file == NULL) {
+        return 0;
+    }
+    if (fscanf(file, "%ld %ld %ld", &pages, &resident, &shared) != 3) {
+        resident = shared = 0;
+    }
+    fclose(file);
+    // shared为映射文件的常驻页, 属于页缓存
+    return (double)(anonymousOnly ? resident - shared : resident) * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+}
+
+static std::string ToText(IRModule &module, const IRFunction *func) {
+    std::ostringstream outs;
+    func->PrintRawString(module.GetTypeManager(), module.GetOperandPool(), outs);
+    return outs.str();
+}
+
+void test16() {
+    WriteBenchModule();
+    auto toMs = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    // 先测按需加载, 避免急切加载释放的内存被复用而影响RSS
+    double rss0 = GetRssMB(false), anon0 = GetRssMB(true);
+    auto t0 = std::chrono::steady_clock::now();
+    IRLazyModule *lazy = new IRLazyModule(BENCH_PATH);
+    auto t1 = std::chrono::steady_clock::now();
+    const int openDeclNum = lazy->GetModule().GetFuncDeclTab().GetFuncDeclNum();
+    for (int i = 0 ; i < BENCH_USED_NUM ; i ++) {
+        lazy->GetFunction(Name("f" + std::to_string(i * (BENCH_FUNC_NUM / BENCH_USED_NUM))));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double rss1 = GetRssMB(false), anon1 = GetRssMB(true);
+    std::cout << "lazy: open " << toMs(t1 - t0) << " ms, " << BENCH_USED_NUM << " functions " << toMs(t2 - t1)
+              << " ms, loaded " << lazy->GetLoadedFunctionNum() << "/" << lazy->GetFunctionNum()
+              << ", pool " << lazy->GetModule().GetOperandPool().GetOperandNum()
+              << ", rss +" << rss1 - rss0 << " MB (anonymous +" << anon1 - anon0 << " MB)" << std::endl;
+
+    auto t3 = std::chrono::steady_clock::now();
+    IRModule *eager = LoadModuleFile(BENCH_PATH);
+    auto t4 = std::chrono::steady_clock::now();
+    double rss2 = GetRssMB(false), anon2 = GetRssMB(true);
+    std::cout << "eager: load " << toMs(t4 - t3) << " ms, loaded " << eager->GetFunctionNum()
+              << ", pool " << eager->GetOperandPool().GetOperandNum()
+              << ", rss +" << rss2 - rss1 << " MB (anonymous +" << anon2 - anon1 << " MB)" << std::endl;
+
+    const IRFunction *lazyFunc = lazy->GetFunction(Name("f123"));
+    const bool same = ToText(lazy->GetModule(), lazyFunc) == ToText(*eager, eager->GetFunction(Name("f123")));
+    std::cout << "f123 " << (same ? "matches" : "DIFFERS") << ", missing: "
+              << (lazy->GetFunction(Name("nope")) == NULL ? "NULL" : "FAILED") << std::endl;
+
+    // 外部函数声明在打开时不解码
+    const IRFuncDecl *lazyNext = lazy->GetExternDecl(Name("next123"));
+    const IRFuncDecl &eagerNext = eager->GetFuncDeclTab().GetFuncDecl(Name("next123"));
+    const bool sameNext = lazyNext != NULL && lazyNext->args.size() == eagerNext.args.size()
+        && lazyNext->args[1].GetName() == eagerNext.args[1].GetName() && lazyNext->returnTypeId == eagerNext.returnTypeId;
+    std::cout << "externs: " << lazy->GetExternDeclNum() << ", decls at open " << openDeclNum
+              << ", next123 " << (sameNext ? "matches" : "DIFFERS") << ", decls now " << lazy->GetModule().GetFuncDeclTab().GetFuncDeclNum()
+              << ", missing: " << (lazy->GetExternDecl(Name("f123")) == NULL ? "NULL" : "FAILED") << std::endl;
+    delete eager;
+    delete lazy;
+    remove(BENCH_PATH);
+
+    // 映射的文件以只读视图访问, 不能被写入
+    const byte image[4] = {1, 2, 3, 4};
+    ByteBuffer view(image, sizeof(image));
+    try {
+        view.Reset();
+        view.WriteByte(0);
+        std::cout << "view: written" << std::endl;
+    }
+    catch (const char *msg) {
+        std::cout << "view: " << msg << ", data " << (int)image[0] << std::endl;
+    }
+}
@@ -0,0 +1,140 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/module.h>
+#include <ir/parser.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+using namespace tayir;
+
+static const int BENCH_FUNC_NUM = 20000;
+static const char *BENCH_PATH = "/tmp/tayir_bench.ir";
+
+// 相对于本文件所在目录(tayir/tests)
+static const char *FIB_RELATIVE_PATH = "../../testbench/tayir/fib.ir";
+
+// 未从命令行给出fib.ir路径时, 由__FILE__推出, 与当前工作目录无关
+static std::string DefaultFibPath() {
+    std::string file = __FILE__;
+    size_t slash = file.find_last_of('/');
+    return (slash == std::string::npos ? std::string() : file.substr(0, slash + 1)) + FIB_RELATIVE_PATH;
+}
+
+static const char CONSTS_SOURCE[] =
+    "def @consts(double %x) {\n"
+    "entry(i64 %y):\n"
+    "    %a = add %x, 1.5\n"
+    "    %b = add %x, 2.5f\n"
+    "    %c = add %x, 'c'\n"
+    "    %d = add %x, true\n"
+    "    %e = add %x, null\n"
+    "    %f = add %x, 123456789012\n"
+    "    %g = add %x, -7\n"
+    "    ret\n"
+    "}\n";
+
+static std::string BuildBenchText() {
+    IRModule module("bench");
+    OperandPool &pool = module.GetOperandPool();
+    TypeManager &man = module.GetTypeManager();
+    int ValN = pool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValCond = pool.GetOrAddSymbol(SymbolScope::LOCAL, "cond");
+    int FuncNext = pool.GetOrAddSymbol(SymbolScope::GLOBAL, "next");
+    int LabelLoop = pool.GetOrAddLabel("loop");
+    int LabelExit = pool.GetOrAddLabel("exit");
+
+    for (int i = 0 ; i < BENCH_FUNC_NUM ; i ++) {
+        IRFunctionBuilder fnBuilder;
+        fnBuilder.GetDecl().name = "f" + std::to_string(i);
+        fnBuilder.GetDecl().conventionId = 0;
+        fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+        fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+        IRBasicBlockBuilder loop;
+        loop.Reserve(64);
+        for (int j = 0 ; j < 61 ; j ++) {
+            loop.AppendIns(Ins(InsType::ADD, ValN, ValN, pool.GetOrAddInt(i * 64 + j)));
+        }
+        loop.AppendIns(Ins(InsType::CALL, ValN, FuncNext, fnBuilder.AppendCallArgs({ValN, pool.GetOrAddInt(i)})));
+        loop.AppendIns(Ins(InsType::LT, ValCond, ValN, pool.GetOrAddInt(i)));
+        loop.AppendIns(Ins(InsType::BR, ValCond, LabelLoop, LabelExit));
+        fnBuilder.AppendBlock(loop.Build("loop"));
+        fnBuilder.AppendBlock(
+            IRBasicBlockBuilder()
+                .AppendIns(Ins(InsType::RET, -1, ValN))
+                .Build("exit")
+        );
+        module.AppendFunction(fnBuilder.Build(pool));
+    }
+    std::ostringstream outs;
+    module.PrintRawString(outs);
+    return outs.str();
+}
+
+static std::string ToText(IRModule &module) {
+    std::ostringstream outs;
+    module.PrintRawString(outs);
+    return outs.str();
+}
+
+void test17(const char *fibPath) {
+    // 直接解析仓库中的fib.ir(其中递归调用写作@fin, 原样保留)
+    const std::string path = fibPath != NULL ? fibPath : DefaultFibPath();
+    IRModule fibModule("fib");
+    try {
+        IRParser(fibModule).ParseFile(path.c_str());
+    }
+    catch (const char *msg) {
+        // 读不到fib.ir时测试失败, 而不是跳过
+        std::cerr << path << ": " << msg << std::endl;
+        exit(1);
+    }
+    IRParser(fibModule).Parse(CONSTS_SOURCE, sizeof(CONSTS_SOURCE) - 1);
+    fibModule.PrintRawString(std::cout);
+
+    const char *badSources[] = {
+        "def @f() {\nentry:\n    %a = add %x, 1\n    %b = frob %a\n}\n",
+        "def @f() {\nentry:\n    goto [1]\n}\n",
+        "def @f() {\nentry:\n    ret [1, 2]\n}\n",
+        "def @f() {\nentry:\n    %a = call @g, [1, [2]]\n}\n",
+    };
+    for (const char *bad : badSources) {
+        IRModule badModule("bad");
+        IRParser badParser(badModule);
+        try {
+            badParser.Parse(bad, strlen(bad));
+            std::cout << "bad: not rejected" << std::endl;
+        }
+        catch (const char *msg) {
+            std::cout << "bad: " << msg << " at line " << badParser.GetErrorLine() << std::endl;
+        }
+    }
+
+    const std::string text = BuildBenchText();
+    FILE *file = fopen(BENCH_PATH, "w");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+    auto toMBps = [&](std::chrono::steady_clock::duration d) {
+        return text.size() / std::chrono::duration<double>(d).count() / (1024 * 1024);
+    };
+
+    IRModule *memModule = new IRModule("bench");
+    auto t0 = std::chrono::steady_clock::now();
+    IRParser(*memModule).Parse(text.data(), text.size());
+    auto t1 = std::chrono::steady_clock::now();
+    IRModule *fileModule = new IRModule("bench");
+    auto t2 = std::chrono::steady_clock::now();
+    IRParser(*fileModule).ParseFile(BENCH_PATH);
+    auto t3 = std::chrono::steady_clock::now();
+
+    std::cout << "corpus: " << BENCH_FUNC_NUM << " functions, " << text.size() / 1024 << " KB" << std::endl;
+    std::cout << "parse: " << toMBps(t1 - t0) << " MB/s (memory), " << toMBps(t3 - t2) << " MB/s (mmap)" << std::endl;
+    std::cout << "round trip " << (ToText(*memModule) == text && ToText(*fileModule) == text ? "matches" : "DIFFERS") << std::endl;
+    delete memModule;
+    delete fileModule;
+    remove(BENCH_PATH);
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/module.h>
+#include <ir/parser.h>
+#include <utils/threadpool.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace tayir;
+
+static const int BENCH_FUNC_NUM = 20000;
+static const char *BENCH_PATH = "/tmp/tayir_parallel.ir";
+
+static std::string BuildBenchText() {
+    IRModule module("bench");
+    OperandPool &pool = module.GetOperandPool();
+    TypeManager &man = module.GetTypeManager();
+    int ValN = pool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValCond = pool.GetOrAddSymbol(SymbolScope::LOCAL, "cond");
+    int LabelLoop = pool.GetOrAddLabel("loop");
+    int LabelExit = pool.GetOrAddLabel("exit");
+
+    for (int i = 0 ; i < BENCH_FUNC_NUM ; i ++) {
+        IRFunctionBuilder fnBuilder;
+        fnBuilder.GetDecl().name = "f" + std::to_string(i);
+        fnBuilder.GetDecl().conventionId = 0;
+        fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+        fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+        IRBasicBlockBuilder loop;
+        loop.Reserve(64);
+        for (int j = 0 ; j < 60 ; j ++) {
+            int ValTmp = pool.GetOrAddSymbol(SymbolScope::LOCAL, "t" + std::to_string(j));
+            loop.AppendIns(Ins(InsType::ADD, ValTmp, ValN, pool.GetOrAddInt(i * 64 + j)));
+        }
+        int FuncNext = pool.GetOrAddSymbol(SymbolScope::GLOBAL, "f" + std::to_string((i + 1) % BENCH_FUNC_NUM));
+        loop.AppendIns(Ins(InsType::CALL, ValN, FuncNext, fnBuilder.AppendCallArgs({ValN, pool.GetOrAddInt(i)})));
+        loop.AppendIns(Ins(InsType::LT, ValCond, ValN, pool.GetOrAddInt(i)));
+        loop.AppendIns(Ins(InsType::BR, ValCond, LabelLoop, LabelExit));
+        fnBuilder.AppendBlock(loop.Build("loop"));
+        fnBuilder.AppendBlock(
+            IRBasicBlockBuilder()
+                .AppendIns(Ins(InsType::RET, -1, ValN))
+                .Build("exit")
+        );
+        module.AppendFunction(fnBuilder.Build(pool));
+    }
+    std::ostringstream outs;
+    module.PrintRawString(outs);
+    return outs.str();
+}
+
+static std::string ToText(IRModule &module) {
+    std::ostringstream outs;
+    module.PrintRawString(outs);
+    return outs.str();
+}
+
+static void ReportError(const std::string &text, ThreadPool *threads) {
+    IRModule module("bad");
+    IRParser parser(module);
+    try {
+        if (threads != NULL) {
+            parser.ParseParallel(text.data(), text.size(), *threads);
+        }
+        else {
+            parser.Parse(text.data(), text.size());
+        }
+        std::cout << "not rejected";
+    }
+    catch (const char *msg) {
+        std::cout << msg << " at line " << parser.GetErrorLine();
+    }
+    std::cout << ", " << module.GetFunctionNum() << " functions, "
+              << module.GetOperandPool().GetOperandNum() << " operands" << std::endl;
+}
+
+void test18() {
+    const std::string text = BuildBenchText();
+    FILE *file = fopen(BENCH_PATH, "w");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+    std::cout << "corpus: " << BENCH_FUNC_NUM << " functions, " << text.size() / 1024 << " KB, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    IRModule serial("bench");
+    auto t0 = std::chrono::steady_clock::now();
+    IRParser(serial).ParseFile(BENCH_PATH);
+    const double serialTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "serial: " << text.size() / serialTime / (1024 * 1024) << " MB/s" << std::endl;
+
+    for (int threadNum : {1, 2, 4, 8}) {
+        ThreadPool threads(threadNum);
+        IRModule module("bench");
+        auto t1 = std::chrono::steady_clock::now();
+        IRParser(module).ParseFile(BENCH_PATH, &threads);
+        const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count();
+        const bool same = ToText(module) == text
+            && module.GetOperandPool().GetOperandNum() == serial.GetOperandPool().GetOperandNum();
+        std::cout << threadNum << " threads: " << text.size() / time / (1024 * 1024) << " MB/s, speedup "
+                  << serialTime / time << "x, " << (same ? "matches" : "DIFFERS") << std::endl;
+    }
+    remove(BENCH_PATH);
+
+    // 并行解析报告与串行解析相同的错误, 并保留出错之前的函数
+    const std::string funcA = "def @a() {\nentry:\n    ret\n}\n";
+    const std::string funcBad = "def @b() {\nentry:\n    %x = frob 1\n}\n";
+    const std::string funcLoop = "def @d() {\nentry:\n    br %x, entry, entry\n}\n";
+    const std::string funcQuote = "def @q() {\nentry:\n    ret '\n}\n";
+    std::string funcs;
+    // 函数数达到并行解析的下限, 否则会直接串行解析
+    for (int i = 0 ; i < PARSE_PARALLEL_MIN_FUNCS ; i ++) {
+        funcs += "def @g" + std::to_string(i) + "() {\nentry:\n    ret %v" + std::to_string(i) + "\n}\n";
+    }
+    const std::string badTexts[] = {
+        funcA + funcBad + funcs + funcLoop,
+        funcA + funcLoop + funcs + funcA,
+        funcs + "def",
+        funcs + funcQuote + funcA,
+        funcs + funcA + "def @e() {\nentry:\n    ret\n" + funcs,
+        funcs + "/* " + funcA,
+        funcs + funcA + "oops\n" + funcLoop,
+    };
+    ThreadPool threads(4);
+    for (const std::string &badText : badTexts) {
+        std::cout << "serial error: ";
+        ReportError(badText, NULL);
+        std::cout << "parallel error: ";
+        ReportError(badText, &threads);
+    }
+}
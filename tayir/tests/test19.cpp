@@ -0,0 +1,68 @@
+#include <ir/ins.h>
+#include <ir/packed.h>
+#include <iostream>
+
+using namespace tayir;
+
+// 操作数分别放在目的数, 操作数1与操作数2字段中
+static void CheckOp(const char *what, int op, bool packable) {
+    const Ins cases[] = {
+        Ins(InsType::ADD, op, 0, 0),
+        Ins(InsType::ADD, 0, op, 0),
+        Ins(InsType::ADD, 0, 0, op),
+    };
+    bool ok = PackedIns::CanPackOp(op) == packable;
+    for (const Ins &ins : cases) {
+        ok = ok && PackedIns::CanPack(ins) == packable;
+        if (packable) {
+            const Ins unpacked = PackedIns(ins).Unpack();
+            ok = ok && unpacked.GetInsType() == ins.GetInsType() && unpacked.GetDestOp() == ins.GetDestOp()
+                && unpacked.GetSrc1Op() == ins.GetSrc1Op() && unpacked.GetSrc2Op() == ins.GetSrc2Op();
+        }
+    }
+    std::cout << what << ": " << (packable ? "packs" : "rejected") << (ok ? "" : " FAILED") << std::endl;
+}
+
+static void CheckArgSpan(int offset, int count, bool packable) {
+    const Ins ins(InsType::CALL, 0, 1, MakeArgSpan(offset, count));
+    bool ok = PackedIns::CanPack(ins) == packable;
+    if (packable) {
+        ok = ok && PackedIns(ins).GetSrc2Op() == ins.GetSrc2Op();
+    }
+    std::cout << "arg span " << offset << "+" << count << ": " << (packable ? "packs" : "rejected") << (ok ? "" : " FAILED") << std::endl;
+}
+
+void test19() {
+    CheckOp("empty", -1, true);
+    CheckOp("imm 65535", MakeInlineImm(65535), true);
+    CheckOp("imm 65536", MakeInlineImm(65536), false);
+    CheckOp("imm -65536", MakeInlineImm(-65536), true);
+    CheckOp("imm -65537", MakeInlineImm(-65537), false);
+    CheckOp("imm 0", MakeInlineImm(0), true);
+    CheckOp("imm -1", MakeInlineImm(-1), true);
+    CheckOp("pool id 0", 0, true);
+    CheckOp("pool id 131070", 131070, true);
+    CheckOp("pool id 131071", 131071, false);
+    CheckOp("pool id 131072", 131072, false);
+    CheckArgSpan(0, 0, true);
+    CheckArgSpan(1023, 255, true);
+    CheckArgSpan(1024, 1, false);
+
+    // 整个切片中只要有一条指令无法编码, 切片即无法编码
+    IRFragmentBuilder builder;
+    builder.AppendIns(Ins(InsType::ADD, 0, 1, MakeInlineImm(65535)));
+    IRFragment *fits = builder.Build();
+    builder.AppendIns(Ins(InsType::ADD, 0, 1, MakeInlineImm(65535)));
+    builder.AppendIns(Ins(InsType::ADD, 0, 1, 131071));
+    IRFragment *overflows = builder.Build();
+    std::cout << "fragment: " << IRPackedFragment::CanPack(*fits) << " " << IRPackedFragment::CanPack(*overflows) << std::endl;
+    try {
+        IRPackedFragment packed(*overflows);
+        std::cout << "overflowing fragment: not rejected" << std::endl;
+    }
+    catch (const char *msg) {
+        std::cout << "overflowing fragment: " << msg << std::endl;
+    }
+    delete fits;
+    delete overflows;
+}
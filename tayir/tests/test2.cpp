@@ -1,5 +1,8 @@
 #include <ir/ins.h>
 #include <ir/slice.h>
+#include <ir/columns.h>
+#include <ir/packed.h>
+#include <ir/valuenum.h>
 #include <iostream>
 
 void test2() {
@@ -7,31 +10,30 @@ void test2() {
 
     TypeManager man;
 
-    //TODO: Const String Pool
     OperandPool opPool;
-    int FuncFib     = opPool.AppendOperand(new SymbolOperand(SymbolScope::GLOBAL,  "fib"));
-
-    int ValN        = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "n"));
-    int ValTmpCond0 = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$cond$0"));
-    int ValTmpCond1 = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$cond$1"));
-    int ValTmpRet0  = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$ret$0"));
-    int ValTmpRet1  = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$ret$1"));
-    int ValTmpRes0  = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$res$0"));
-    int ValTmpRes1  = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$res$1"));
-    int ValTmpRes2  = opPool.AppendOperand(new SymbolOperand(SymbolScope::LOCAL,   "tmp$res$2"));
-    
-    int LabelIf0    = opPool.AppendOperand(new LabelOperand("if0"));
-    int LabelElse0  = opPool.AppendOperand(new LabelOperand("else0"));
-    int LabelElse1  = opPool.AppendOperand(new LabelOperand("else1"));
+    int FuncFib     = opPool.GetOrAddSymbol(SymbolScope::GLOBAL, "fib");
 
-    int ArgComp1    = opPool.AppendOperand(new ArgListOperand({ValTmpRes0}));
-    int ArgComp2    = opPool.AppendOperand(new ArgListOperand({ValTmpRes1}));
+    int ValN        = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValTmpCond0 = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$cond$0");
+    int ValTmpCond1 = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$cond$1");
+    int ValTmpRet0  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$ret$0");
+    int ValTmpRet1  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$ret$1");
+    int ValTmpRes0  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$0");
+    int ValTmpRes1  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$1");
+    int ValTmpRes2  = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "tmp$res$2");
+    
+    int LabelIf0    = opPool.GetOrAddLabel("if0");
+    int LabelElse0  = opPool.GetOrAddLabel("else0");
+    int LabelElse1  = opPool.GetOrAddLabel("else1");
 
-    int Const0      = opPool.AppendOperand(new ImmediateOperand(imm::itype::I32, ImmediateValue{.i32Val = 0}));
-    int Const1      = opPool.AppendOperand(new ImmediateOperand(imm::itype::I32, ImmediateValue{.i32Val = 1}));
-    int Const2      = opPool.AppendOperand(new ImmediateOperand(imm::itype::I32, ImmediateValue{.i32Val = 2}));
+    int Const0      = opPool.GetOrAddInt(0);
+    int Const1      = opPool.GetOrAddInt(1);
+    int Const2      = opPool.GetOrAddInt(2);
 
     IRFunctionBuilder fnBuilder;
+    int ArgComp1    = fnBuilder.AppendCallArgs({ValTmpRes0});
+    int ArgComp2    = fnBuilder.AppendCallArgs({ValTmpRes1});
+
     fnBuilder.GetDecl().name = "fib";
     fnBuilder.GetDecl().conventionId = 0;
     fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
@@ -68,7 +70,69 @@ void test2() {
             .Build("else1")
     );
 
-    IRFunction *func = fnBuilder.Build();
+    IRFunction *func = fnBuilder.Build(opPool);
     func->PrintRawString(man, opPool, std::cout);
+
+    for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+        const IRBasicBlock *block = func->GetBlock(i);
+        const Ins last = block->GetIns(block->GetInsNum() - 1);
+        for (int j = 0 ; j < IRFunction::GetSuccessorNum(last) ; j ++) {
+            std::cout << block->GetName() << " -> " << func->GetSuccessorBlock(last, j)->GetName() << std::endl;
+        }
+    }
+    IRColumnFragment columns(*func);
+    std::vector<int> calls, defs;
+    columns.FindIns(InsType::CALL, calls);
+    columns.CollectDefs(defs);
+    std::cout << "calls:";
+    for (int sub : calls) {
+        std::cout << " " << sub;
+    }
+    std::cout << std::endl << "defs:";
+    for (int def : defs) {
+        std::cout << " " << opPool.ToString(def);
+    }
+    std::cout << std::endl;
+
+    IRPackedFragment packed(*func);
+    std::cout << "packed: " << packed.GetByteSize() << " bytes, unpacked: " << sizeof(Ins) * func->GetInsNum() << " bytes" << std::endl;
+    for (int i = 0 ; i < packed.GetInsNum() ; i ++) {
+        const Ins ins = packed.GetIns(i);
+        if (ins.GetInsType() != func->GetIns(i).GetInsType() || ins.GetSrc2Op() != func->GetIns(i).GetSrc2Op()) {
+            std::cout << "packed mismatch at " << i << std::endl;
+        }
+    }
+
+    IRValueNumbering numbering(func, opPool);
+    std::cout << "values:";
+    for (int i = 0 ; i < numbering.GetValueNum() ; i ++) {
+        std::cout << " " << i << "=" << opPool.ToString(numbering.GetOperand(i));
+    }
+    std::cout << std::endl;
+
+    // 驻留: 重复获取返回相同ID且不追加操作数, FindSymbol只查找
+    ImmediateValue wide = {};
+    wide.i64Val = 123456789012;
+    ImmediateValue narrow = {};
+    narrow.i8Val = 5;
+    ImmediateValue dirty;
+    dirty.ui64Val = 0x123456789abcde05;
+    int ImmWide   = opPool.GetOrAddImmediate(imm::itype::I64, wide);
+    int ImmNarrow = opPool.GetOrAddImmediate(imm::itype::I8, narrow);
+    int GlobalN   = opPool.GetOrAddSymbol(SymbolScope::GLOBAL, "n");
+    int BigInt    = opPool.GetOrAddInt(INLINE_IMM_MAX + 1);
+    const int operandNum = opPool.GetOperandNum();
+    auto check = [](const char *what, bool ok) {
+        std::cout << "intern " << what << ": " << (ok ? "ok" : "FAILED") << std::endl;
+    };
+    check("immediate", opPool.GetOrAddImmediate(imm::itype::I64, wide) == ImmWide);
+    check("high bytes", opPool.GetOrAddImmediate(imm::itype::I8, dirty) == ImmNarrow);
+    check("int", opPool.GetOrAddInt(2) == Const2 && opPool.GetOrAddInt(INLINE_IMM_MAX + 1) == BigInt);
+    check("symbol", opPool.GetOrAddSymbol(SymbolScope::LOCAL, "n") == ValN && opPool.GetOrAddSymbol(SymbolScope::GLOBAL, "fib") == FuncFib);
+    check("scope", GlobalN != ValN && opPool.GetOrAddSymbol(SymbolScope::GLOBAL, "n") == GlobalN);
+    check("label", opPool.GetOrAddLabel("if0") == LabelIf0 && opPool.GetOrAddLabel("else1") == LabelElse1);
+    check("find", opPool.FindSymbol(SymbolScope::LOCAL, "tmp$res$2") == ValTmpRes2 && opPool.FindSymbol(SymbolScope::LOCAL, "missing") == -1);
+    check("operand num", opPool.GetOperandNum() == operandNum);
+
     delete func;
 }
\ No newline at end of file
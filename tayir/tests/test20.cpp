@@ -0,0 +1,67 @@
+#include <ir/module.h>
+#include <ir/parser.h>
+#include <utils/interner.h>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tayir;
+
+static const int INTERN_THREAD_NUM = 4;
+static const int INTERN_STRING_NUM = 20000;
+
+static const char SCOPED_SOURCE[] =
+    "def @only_here(i32 %x) {\n"
+    "entry:\n"
+    "    %y = add %x, 1\n"
+    "    ret %y\n"
+    "}\n";
+
+void test20() {
+    StringInterner interner;
+    const NameId abc = interner.Intern("abc");
+    std::cout << "same id: " << (interner.Intern(std::string("abc")) == abc ? "ok" : "FAILED")
+              << ", distinct: " << (interner.Intern("abd") != abc ? "ok" : "FAILED")
+              << ", round trip: " << (interner.GetString(abc) == "abc" ? "ok" : "FAILED")
+              << ", empty id: " << interner.Intern("") << std::endl;
+
+    // 各线程以不同顺序驻留同一批字符串, 每个字符串只能得到一个ID
+    std::vector<std::vector<NameId>> ids(INTERN_THREAD_NUM, std::vector<NameId>(INTERN_STRING_NUM));
+    std::vector<std::thread> threads;
+    for (int t = 0 ; t < INTERN_THREAD_NUM ; t ++) {
+        threads.emplace_back([&interner, &ids, t] {
+            for (int i = 0 ; i < INTERN_STRING_NUM ; i ++) {
+                const int sub = (t % 2 == 0) ? i : INTERN_STRING_NUM - 1 - i;
+                ids[t][sub] = interner.Intern("s" + std::to_string(sub));
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    bool consistent = interner.GetStringNum() == INTERN_STRING_NUM + 3;
+    for (int i = 0 ; i < INTERN_STRING_NUM ; i ++) {
+        for (int t = 1 ; t < INTERN_THREAD_NUM ; t ++) {
+            consistent = consistent && ids[t][i] == ids[0][i];
+        }
+        consistent = consistent && interner.GetString(ids[0][i]) == "s" + std::to_string(i);
+    }
+    std::cout << "concurrent intern: " << (consistent ? "ok" : "FAILED") << std::endl;
+
+    // 作用域内的名称驻留在模块自己的驻留表中, 全局驻留表不变, 用完后整体释放
+    const int globalNum = StringInterner::GetGlobal().GetStringNum();
+    StringInterner *scoped = new StringInterner();
+    std::string text;
+    {
+        InternerScope scope(*scoped);
+        IRModule module("scoped");
+        IRParser(module).Parse(SCOPED_SOURCE, sizeof(SCOPED_SOURCE) - 1);
+        text = module.GetFunction(Name("only_here")) != NULL ? "found" : "missing";
+        text += Name("only_here").View() == "only_here" ? ", view ok" : ", view FAILED";
+    }
+    std::cout << "scoped module: " << text << ", scoped names " << scoped->GetStringNum()
+              << ", global grew " << StringInterner::GetGlobal().GetStringNum() - globalNum << std::endl;
+    delete scoped;
+    std::cout << "after scope: " << (Name("abc").View() == "abc" && &StringInterner::GetCurrent() == &StringInterner::GetGlobal() ? "global" : "FAILED") << std::endl;
+}
@@ -0,0 +1,56 @@
+#include <ir/operand.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+using namespace tayir;
+
+static const int BENCH_OPERAND_NUM = 1000000;
+
+static double BenchOperandPool(OperandPoolMode mode, size_t &chars, size_t &arenaBytes) {
+    auto begin = std::chrono::steady_clock::now();
+    {
+        OperandPool pool(mode);
+        for (int i = 0 ; i < BENCH_OPERAND_NUM ; i ++) {
+            switch (i & 3) {
+            case 0: pool.AppendSymbol(SymbolScope::LOCAL, "tmp$res$" + std::to_string(i)); break;
+            case 1: pool.AppendLabel("label" + std::to_string(i)); break;
+            case 2: pool.AppendImmediate(imm::itype::I32, ImmediateValue{.i32Val = i}); break;
+            case 3: pool.AppendArgList({i - 3, i - 1}); break;
+            }
+        }
+        chars = 0;
+        for (int i = 0 ; i < pool.GetOperandNum() ; i ++) {
+            chars += pool.ToString(i).length();
+        }
+        arenaBytes = pool.GetArenaBytes();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+void test3() {
+    size_t heapChars, arenaChars, heapBytes, arenaBytes;
+    double heapMs = BenchOperandPool(OperandPoolMode::HEAP, heapChars, heapBytes);
+    double arenaMs = BenchOperandPool(OperandPoolMode::ARENA, arenaChars, arenaBytes);
+
+    std::cout << "operand pool (" << BENCH_OPERAND_NUM << " operands, build + print + teardown):" << std::endl;
+    std::cout << "heap:  " << heapMs << " ms" << std::endl;
+    std::cout << "arena: " << arenaMs << " ms, " << arenaBytes / 1024 << " KiB" << std::endl;
+    std::cout << "speedup: " << heapMs / arenaMs << "x" << std::endl;
+    std::cout << (heapChars == arenaChars ? "output match" : "output mismatch!") << std::endl;
+
+    for (OperandPoolMode mode : {OperandPoolMode::HEAP, OperandPoolMode::ARENA}) {
+        OperandPool pool(mode);
+        try {
+            pool.GetOperandType(5);
+            std::cout << "out of range id: not rejected" << std::endl;
+        }
+        catch (const char *msg) {
+            std::cout << "out of range id: " << msg << std::endl;
+        }
+        catch (const std::out_of_range &) {
+            std::cout << "out of range id: out_of_range" << std::endl;
+        }
+    }
+}
\ No newline at end of file
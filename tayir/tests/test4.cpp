@@ -0,0 +1,67 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <chrono>
+#include <iostream>
+
+using namespace tayir;
+
+static const int BENCH_BLOCK_NUM = 1000;
+static const int BENCH_BLOCK_INS_NUM = 100;
+
+static const Ins LinearGetIns(const IRFunction *func, int sub) {
+    for (int i = 0 ; i < func->GetBlockNum() ; i ++) {
+        if (sub < func->GetBlock(i)->GetInsNum()) {
+            return func->GetBlock(i)->GetIns(sub);
+        }
+        sub -= func->GetBlock(i)->GetInsNum();
+    }
+    throw "Unreachable!";
+}
+
+void test4() {
+    OperandPool opPool;
+    int ValX = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "x");
+
+    IRFunctionBuilder fnBuilder;
+    fnBuilder.GetDecl().name = "walk";
+    for (int i = 0 ; i < BENCH_BLOCK_NUM ; i ++) {
+        IRBasicBlockBuilder blockBuilder;
+        for (int j = 0 ; j < BENCH_BLOCK_INS_NUM ; j ++) {
+            blockBuilder.AppendIns(Ins(InsType::ADD, ValX, ValX, i * BENCH_BLOCK_INS_NUM + j));
+        }
+        fnBuilder.AppendBlock(blockBuilder.Build("b" + std::to_string(i)));
+    }
+    IRFunction *func = fnBuilder.Build();
+
+    long long sumLinear = 0, sumIndexed = 0, sumIter = 0, sumSpan = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < func->GetInsNum() ; i ++) {
+        sumLinear += LinearGetIns(func, i).GetSrc2Op();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < func->GetInsNum() ; i ++) {
+        sumIndexed += func->GetIns(i).GetSrc2Op();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (const Ins ins : *func) {
+        sumIter += ins.GetSrc2Op();
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    IRFunction::InsRange range = func->Instructions();
+    for (int i = 0 ; i < range.GetSegmentNum() ; i ++) {
+        for (const Ins &ins : range.GetSegment(i)) {
+            sumSpan += ins.GetSrc2Op();
+        }
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    std::cout << "walk " << func->GetInsNum() << " instructions in " << func->GetBlockNum() << " blocks:" << std::endl;
+    std::cout << "linear scan:  " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "offset index: " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "iterator:     " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms" << std::endl;
+    std::cout << "block spans:  " << std::chrono::duration<double, std::milli>(t4 - t3).count() << " ms" << std::endl;
+    std::cout << ((sumLinear == sumIndexed && sumIndexed == sumIter && sumIter == sumSpan) ? "result match" : "result mismatch!") << std::endl;
+
+    delete func;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <chrono>
+#include <iostream>
+
+using namespace tayir;
+
+static const int BENCH_FRAG_NUM = 2000;
+static const int BENCH_FRAG_INS_NUM = 500;
+
+/**
+ * 基线: 原来的IRFragmentBuilder::Build与IRFragment构造函数
+ * Build按值传递指令列表(复制一次), 构造函数再逐条复制到new Ins[]
+ */
+static int BuildByCopy(std::vector<Ins> insList) {
+    const int insNum = insList.size();
+    Ins *instructions = new Ins[insNum];
+    for (int i = 0 ; i < insNum ; i ++) {
+        instructions[i] = insList.at(i);
+    }
+    delete[] instructions;
+    return insNum;
+}
+
+void test5() {
+    OperandPool opPool;
+    int ValX = opPool.GetOrAddSymbol(SymbolScope::LOCAL, "x");
+
+    long long sumCopy = 0, sumMove = 0;
+
+    // 基线: Builder不预留空间, Build时复制
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < BENCH_FRAG_NUM ; i ++) {
+        std::vector<Ins> builderList;
+        for (int j = 0 ; j < BENCH_FRAG_INS_NUM ; j ++) {
+            builderList.push_back(Ins(InsType::ADD, ValX, ValX, j));
+        }
+        sumCopy += BuildByCopy(builderList);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    // 预留空间后直接追加, Build时移交存储
+    for (int i = 0 ; i < BENCH_FRAG_NUM ; i ++) {
+        IRFragmentBuilder builder;
+        builder.Reserve(BENCH_FRAG_INS_NUM);
+        for (int j = 0 ; j < BENCH_FRAG_INS_NUM ; j ++) {
+            builder.AppendIns(Ins(InsType::ADD, ValX, ValX, j));
+        }
+        IRFragment *frag = builder.Build();
+        sumMove += frag->GetInsNum();
+        delete frag;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Build后Builder应为空
+    IRBasicBlockBuilder blockBuilder;
+    blockBuilder.AppendIns(Ins(InsType::NOP, -1, -1, -1));
+    IRBasicBlock *first = blockBuilder.Build("first");
+    IRBasicBlock *second = blockBuilder.Build("second");
+
+    double copyMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double moveMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    std::cout << "build " << BENCH_FRAG_NUM << " fragments of " << BENCH_FRAG_INS_NUM << " instructions:" << std::endl;
+    std::cout << "copying build:   " << copyMs << " ms" << std::endl;
+    std::cout << "reserve + move:  " << moveMs << " ms" << std::endl;
+    std::cout << ((sumCopy == sumMove) ? "result match" : "result mismatch!") << std::endl;
+    std::cout << ((first->GetInsNum() == 1 && second->GetInsNum() == 0) ? "builder reset" : "builder not reset!") << std::endl;
+
+    delete first;
+    delete second;
+}
\ No newline at end of file
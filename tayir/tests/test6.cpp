@@ -0,0 +1,79 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/module.h>
+#include <chrono>
+#include <iostream>
+#include <optional>
+
+using namespace tayir;
+
+static const int MODULE_FUNC_NUM = 200;
+static const int MODULE_ROUND_NUM = 20;
+
+// round为0时函数名为f0, f1...; 其余各轮的名称各不相同
+static IRModule *BuildModule(int round, bool ownInterner) {
+    IRModule *module = new IRModule("bench", ownInterner);
+    std::optional<InternerScope> scope;
+    if (ownInterner) {
+        scope.emplace(*module->GetInterner());
+    }
+    const std::string prefix = round == 0 ? "f" : "r" + std::to_string(round) + "f";
+    OperandPool &pool = module->GetOperandPool();
+    TypeManager &man = module->GetTypeManager();
+    int ValN = pool.GetOrAddSymbol(SymbolScope::LOCAL, "n");
+    int ValCond = pool.GetOrAddSymbol(SymbolScope::LOCAL, "cond");
+    int LabelLoop = pool.GetOrAddLabel("loop");
+    int LabelExit = pool.GetOrAddLabel("exit");
+
+    for (int i = 0 ; i < MODULE_FUNC_NUM ; i ++) {
+        IRFunctionBuilder fnBuilder;
+        fnBuilder.GetDecl().name = prefix + std::to_string(i);
+        fnBuilder.GetDecl().conventionId = 0;
+        fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+        fnBuilder.GetDecl().args.push_back(Argument(man.GetI32Id(), "n"));
+
+        IRBasicBlockBuilder loop;
+        loop.Reserve(64);
+        for (int j = 0 ; j < 62 ; j ++) {
+            loop.AppendIns(Ins(InsType::ADD, ValN, ValN, pool.GetOrAddInt(i * 64 + j)));
+        }
+        loop.AppendIns(Ins(InsType::LT, ValCond, ValN, pool.GetOrAddInt(i)));
+        loop.AppendIns(Ins(InsType::BR, ValCond, LabelLoop, LabelExit));
+        fnBuilder.AppendBlock(loop.Build("loop"));
+        fnBuilder.AppendBlock(
+            IRBasicBlockBuilder()
+                .AppendIns(Ins(InsType::RET, -1, ValN))
+                .Build("exit")
+        );
+        module->AppendFunction(fnBuilder.Build(pool));
+    }
+    return module;
+}
+
+void test6() {
+    IRModule *module = BuildModule(0, false);
+    module->PrintMemoryReport(std::cout);
+    std::cout << "lookup f7: " << module->GetFunction("f7")->GetInsNum() << " instructions" << std::endl;
+    delete module;
+
+    module = BuildModule(0, true);
+    {
+        InternerScope scope(*module->GetInterner());
+        module->PrintMemoryReport(std::cout);
+        std::cout << "lookup f7: " << module->GetFunction("f7")->GetInsNum() << " instructions" << std::endl;
+    }
+    delete module;
+
+    // 反复构建与释放, 模拟长期运行的编译进程; 模块有自己的驻留表时全局驻留表不再增长
+    for (bool ownInterner : {false, true}) {
+        const int globalNum = StringInterner::GetGlobal().GetStringNum();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0 ; i < MODULE_ROUND_NUM ; i ++) {
+            delete BuildModule((ownInterner ? MODULE_ROUND_NUM : 0) + i + 1, ownInterner);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << MODULE_ROUND_NUM << " build/teardown rounds (" << (ownInterner ? "own" : "shared") << " interner): "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, global names +"
+                  << StringInterner::GetGlobal().GetStringNum() - globalNum << std::endl;
+    }
+}
\ No newline at end of file
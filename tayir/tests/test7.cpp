@@ -0,0 +1,101 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/defuse.h>
+#include <chrono>
+#include <iostream>
+
+using namespace tayir;
+
+static const int CHAIN_LENGTH = 5000;
+
+static IRFunction *BuildChain(OperandPool &pool, std::vector<int> &values) {
+    IRBasicBlockBuilder blockBuilder;
+    blockBuilder.Reserve(CHAIN_LENGTH + 1);
+    values.push_back(pool.GetOrAddSymbol(SymbolScope::LOCAL, "v0"));
+    for (int i = 1 ; i <= CHAIN_LENGTH ; i ++) {
+        values.push_back(pool.GetOrAddSymbol(SymbolScope::LOCAL, "v" + std::to_string(i)));
+        blockBuilder.AppendIns(Ins(InsType::ADD, values[i], values[i - 1], pool.GetOrAddInt(1)));
+    }
+    blockBuilder.AppendIns(Ins(InsType::RET, -1, values[CHAIN_LENGTH]));
+    IRFunctionBuilder fnBuilder;
+    fnBuilder.GetDecl().name = "chain";
+    fnBuilder.AppendBlock(blockBuilder.Build("entry"));
+    return fnBuilder.Build();
+}
+
+void test7() {
+    OperandPool pool;
+    int ValA   = pool.GetOrAddSymbol(SymbolScope::LOCAL, "a");
+    int ValB   = pool.GetOrAddSymbol(SymbolScope::LOCAL, "b");
+    int ValC   = pool.GetOrAddSymbol(SymbolScope::LOCAL, "c");
+    int ValD   = pool.GetOrAddSymbol(SymbolScope::LOCAL, "d");
+    int ValRet = pool.GetOrAddSymbol(SymbolScope::LOCAL, "ret");
+    int FuncG  = pool.GetOrAddSymbol(SymbolScope::GLOBAL, "g");
+    int ArgAB  = pool.AppendArgList({ValA, ValB});
+
+    TypeManager man;
+    IRFunctionBuilder fnBuilder;
+    int ArgCA  = fnBuilder.AppendCallArgs({ValC, ValA});
+    fnBuilder.GetDecl().name = "f";
+    fnBuilder.GetDecl().conventionId = 0;
+    fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::ADD,  ValB,   ValA, ValA))
+            .AppendIns(Ins(InsType::CALL, ValRet, FuncG, ArgAB))
+            .AppendIns(Ins(InsType::MUL,  ValC,   ValRet, ValB))
+            .AppendIns(Ins(InsType::CALL, ValD,   FuncG, ArgCA))
+            .AppendIns(Ins(InsType::RET,  -1,     ValD))
+            .Build("entry")
+    );
+    IRFunction *func = fnBuilder.Build();
+
+    IRDefUse defUse(func, pool);
+    std::vector<IRUse> users;
+    std::cout << "uses of a: " << defUse.GetUseNum(ValA) << ", users: " << defUse.GetUsers(ValA, users) << std::endl;
+    users.clear();
+    std::cout << "uses of b: " << defUse.GetUseNum(ValB) << ", users: " << defUse.GetUsers(ValB, users) << std::endl;
+
+    std::cout << "replace a with 7: " << defUse.ReplaceAllUsesWith(ValA, pool.GetOrAddInt(7)) << " uses" << std::endl;
+    std::cout << "replace ret with b: " << defUse.ReplaceAllUsesWith(ValRet, ValB) << " uses" << std::endl;
+    std::cout << "uses of b: " << defUse.GetUseNum(ValB) << std::endl;
+    func->PrintRawString(man, pool, std::cout);
+    std::cout << "pool list unchanged: " << (pool.GetArg(ArgAB, 0) == ValA && pool.GetArg(ArgAB, 1) == ValB ? "yes" : "no") << std::endl;
+    delete func;
+
+    // 逐个将链上的值替换为v0: 扫描整个函数 vs 使用列表
+    OperandPool chainPool;
+    std::vector<int> values;
+    IRFunction *scanChain = BuildChain(chainPool, values);
+    IRFunction *listChain = BuildChain(chainPool, values);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 1 ; i <= CHAIN_LENGTH ; i ++) {
+        for (Ins &ins : scanChain->GetBlock(0)->Instructions()) {
+            if (ins.GetSrc1Op() == values[i]) {
+                ins.SetSrc1Op(values[0]);
+            }
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    IRDefUse chainDefUse(listChain, chainPool);
+    for (int i = 1 ; i <= CHAIN_LENGTH ; i ++) {
+        chainDefUse.ReplaceAllUsesWith(values[i], values[0]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    bool match = true;
+    for (int i = 0 ; i <= CHAIN_LENGTH ; i ++) {
+        if (scanChain->GetIns(i).GetSrc1Op() != listChain->GetIns(i).GetSrc1Op()) {
+            match = false;
+        }
+    }
+    std::cout << "replace " << CHAIN_LENGTH << " values:" << std::endl;
+    std::cout << "full scan: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "use lists: " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << (match ? "result match" : "result mismatch!") << std::endl;
+    std::cout << "uses of v0: " << chainDefUse.GetUseNum(values[0]) << std::endl;
+
+    delete scanChain;
+    delete listChain;
+}
\ No newline at end of file
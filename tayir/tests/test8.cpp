@@ -0,0 +1,139 @@
+#include <utils/bitset.h>
+#include <utils/sparseset.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace tayir;
+
+static const int BENCH_SIZES[] = {1024, 64 * 1024, 1024 * 1024};
+static const long long BENCH_BITS_PER_SIZE = 1ll << 30;
+
+static void FillPattern(BitSet &set, std::vector<bool> &ref, int seed) {
+    unsigned int x = seed;
+    for (int i = 0 ; i < set.GetBitNum() ; i ++) {
+        x = x * 1103515245 + 12345;
+        if ((x >> 16) % 3 == 0) {
+            set.Set(i);
+            ref[i] = true;
+        }
+    }
+}
+
+static bool CheckBitSet() {
+    const int bitNum = 1000;
+    BitSet a(bitNum), b(bitNum);
+    std::vector<bool> ra(bitNum), rb(bitNum);
+    FillPattern(a, ra, 1);
+    FillPattern(b, rb, 2);
+
+    BitSet u(a), n(a), d(a);
+    u.UnionWith(b);
+    n.IntersectWith(b);
+    d.DifferenceWith(b);
+    for (int i = 0 ; i < bitNum ; i ++) {
+        if (u.Test(i) != (ra[i] || rb[i]) || n.Test(i) != (ra[i] && rb[i]) || d.Test(i) != (ra[i] && ! rb[i])) {
+            return false;
+        }
+    }
+    int count = 0, last = -1;
+    for (int sub : u) {
+        if (sub <= last || ! u.Test(sub)) {
+            return false;
+        }
+        last = sub;
+        count ++;
+    }
+    if (count != u.Count() || u.UnionWith(b) || ! n.UnionWith(d)) {
+        return false;
+    }
+    BitSet full(bitNum);
+    full.Fill();
+    return full.Count() == bitNum && n == BitSet(n);
+}
+
+static bool CheckSparseSet() {
+    SparseSet set(100);
+    set.Insert(5);
+    set.Insert(42);
+    set.Insert(7);
+    if (set.Insert(42) || set.GetSize() != 3 || ! set.Contains(7)) {
+        return false;
+    }
+    set.Erase(5);
+    if (set.Contains(5) || set.GetSize() != 2 || set[0] != 7) {
+        return false;
+    }
+    set.Clear();
+    return set.IsEmpty() && ! set.Contains(42);
+}
+
+void test8() {
+    std::cout << "bit set: " << (CheckBitSet() ? "ok" : "wrong!") << std::endl;
+    std::cout << "sparse set: " << (CheckSparseSet() ? "ok" : "wrong!") << std::endl;
+
+    for (int bitNum : BENCH_SIZES) {
+        BitSet a(bitNum), b(bitNum);
+        std::vector<bool> ra(bitNum), rb(bitNum);
+        FillPattern(a, ra, 1);
+        FillPattern(b, rb, 2);
+        const int rounds = BENCH_BITS_PER_SIZE / bitNum;
+
+        // 基线: 逐位处理的vector<bool>
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r = 0 ; r < rounds / 16 ; r ++) {
+            for (int i = 0 ; i < bitNum ; i ++) {
+                ra[i] = ra[i] || rb[i];
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        int changes = 0;
+        for (int r = 0 ; r < rounds ; r ++) {
+            changes += a.UnionWith(b);
+            changes += a.IntersectWith(b);
+            changes += a.DifferenceWith(b);
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (int r = 0 ; r < rounds / 16 ; r ++) {
+            for (int sub : b) {
+                sum += sub;
+            }
+        }
+        auto t3 = std::chrono::steady_clock::now();
+
+        double refNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds / 16);
+        double opNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / rounds / 3;
+        double iterNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / (rounds / 16);
+        std::cout << bitNum << " bits: vector<bool> union " << refNs << " ns, "
+                  << "bitset op " << opNs << " ns, "
+                  << "iterate " << iterNs << " ns (" << b.Count() << " elements, checksum " << sum + changes << ")" << std::endl;
+    }
+
+    const int capacity = 64 * 1024;
+    const int rounds = 1000;
+    SparseSet work(capacity);
+    BitSet workBits(capacity);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0 ; r < rounds ; r ++) {
+        for (int i = 0 ; i < 64 ; i ++) {
+            work.Insert((i * 997 + r) % capacity);
+        }
+        while (! work.IsEmpty()) {
+            work.Pop();
+        }
+        work.Clear();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0 ; r < rounds ; r ++) {
+        for (int i = 0 ; i < 64 ; i ++) {
+            workBits.Set((i * 997 + r) % capacity);
+        }
+        for (int sub : workBits) {
+            workBits.Reset(sub);
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "worklist of 64 in " << capacity << ": sparse set " << std::chrono::duration<double, std::micro>(t1 - t0).count() / rounds << " us, "
+              << "bit set " << std::chrono::duration<double, std::micro>(t2 - t1).count() / rounds << " us" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <ir/ins.h>
+#include <ir/slice.h>
+#include <ir/editable.h>
+#include <chrono>
+#include <iostream>
+
+using namespace tayir;
+
+static const int EDIT_BLOCK_INS_NUM = 20000;
+static const int EDIT_INSERT_NUM = 2000;
+
+void test9() {
+    OperandPool pool;
+    TypeManager man;
+    int ValX = pool.GetOrAddSymbol(SymbolScope::LOCAL, "x");
+    int ValY = pool.GetOrAddSymbol(SymbolScope::LOCAL, "y");
+    int ValZ = pool.GetOrAddSymbol(SymbolScope::LOCAL, "z");
+    int ValDead = pool.GetOrAddSymbol(SymbolScope::LOCAL, "dead");
+
+    IRFunctionBuilder fnBuilder;
+    fnBuilder.GetDecl().name = "edit";
+    fnBuilder.GetDecl().returnTypeId = man.GetI32Id();
+    fnBuilder.AppendBlock(
+        IRBasicBlockBuilder()
+            .AppendIns(Ins(InsType::ADD, ValY, ValX, pool.GetOrAddInt(1)))
+            .AppendIns(Ins(InsType::MUL, ValDead, ValX, ValX))
+            .AppendIns(Ins(InsType::RET, -1, ValY))
+            .Build("entry")
+    );
+    IRFunction *func = fnBuilder.Build();
+
+    // 删除无用指令, 并在返回前插入一条指令
+    IREditableBlock editable(func->GetBlock(0));
+    int dead = editable.Next(editable.First());
+    int ret = editable.Erase(dead);
+    int inserted = editable.InsertBefore(ret, Ins(InsType::SUB, ValZ, ValY, pool.GetOrAddInt(2)));
+    editable.GetIns(ret).SetSrc1Op(ValZ);
+    int nop = editable.InsertAfter(inserted, Ins());
+    editable.Erase(nop);
+    func->ReplaceBlock(0, editable.Freeze(), pool);
+    try {
+        editable.Erase(nop);
+        std::cout << "erase twice: not rejected" << std::endl;
+    }
+    catch (const char *msg) {
+        std::cout << "erase twice: " << msg << std::endl;
+    }
+    func->PrintRawString(man, pool, std::cout);
+    std::cout << "instructions: " << func->GetInsNum() << std::endl;
+    delete func;
+
+    // 编辑时加入跳转到此前没有被引用过的标号
+    IRFunctionBuilder jumpBuilder;
+    jumpBuilder.GetDecl().name = "jump";
+    jumpBuilder.GetDecl().returnTypeId = -1;
+    jumpBuilder.AppendBlock(IRBasicBlockBuilder().AppendIns(Ins(InsType::RET, -1, -1)).Build("a"));
+    jumpBuilder.AppendBlock(IRBasicBlockBuilder().AppendIns(Ins(InsType::RET, -1, -1)).Build("b"));
+    IRFunction *jump = jumpBuilder.Build(pool);
+    IREditableBlock jumpEdit(jump->GetBlock(0));
+    jumpEdit.InsertBefore(jumpEdit.First(), Ins(InsType::GOTO, -1, pool.GetOrAddLabel("b")));
+    jump->ReplaceBlock(0, jumpEdit.Freeze(), pool);
+    std::cout << "inserted goto b -> block " << jump->GetSuccessorSub(jump->GetIns(0), 0) << std::endl;
+    delete jump;
+
+    // 在大基本块中部反复插入: 连续数组 vs 链表
+    std::vector<Ins> flat;
+    IREditableBlock list("bench");
+    for (int i = 0 ; i < EDIT_BLOCK_INS_NUM ; i ++) {
+        flat.push_back(Ins(InsType::ADD, ValX, ValX, pool.GetOrAddInt(i)));
+        list.AppendIns(Ins(InsType::ADD, ValX, ValX, pool.GetOrAddInt(i)));
+    }
+    int middle = list.First();
+    for (int i = 0 ; i < EDIT_BLOCK_INS_NUM / 2 ; i ++) {
+        middle = list.Next(middle);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < EDIT_INSERT_NUM ; i ++) {
+        flat.insert(flat.begin() + EDIT_BLOCK_INS_NUM / 2, Ins(InsType::NOP, -1, -1, -1));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0 ; i < EDIT_INSERT_NUM ; i ++) {
+        list.InsertBefore(middle, Ins(InsType::NOP, -1, -1, -1));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    IRBasicBlock *frozen = list.Freeze();
+    auto t3 = std::chrono::steady_clock::now();
+
+    bool match = (int)flat.size() == frozen->GetInsNum();
+    for (int i = 0 ; match && i < frozen->GetInsNum() ; i ++) {
+        match = flat[i].GetInsType() == frozen->GetIns(i).GetInsType() && flat[i].GetSrc2Op() == frozen->GetIns(i).GetSrc2Op();
+    }
+    std::cout << "insert " << EDIT_INSERT_NUM << " into " << EDIT_BLOCK_INS_NUM << " instructions:" << std::endl;
+    std::cout << "array insert: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+    std::cout << "list insert:  " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "freeze:       " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms" << std::endl;
+    std::cout << (match ? "result match" : "result mismatch!") << std::endl;
+    delete frozen;
+}
\ No newline at end of file
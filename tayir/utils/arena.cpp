@@ -0,0 +1,162 @@
+/**
+ * @file arena.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 单调内存池
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <utils/arena.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace tayir {
+    /**
+     * @brief Arena构造函数
+     * 
+     * @param chunkSize 默认内存块大小
+     */
+    Arena::Arena(size_t chunkSize)
+        : current(NULL), pos(NULL), end(NULL), first(NULL), chunkSize(chunkSize), usedBytes(0), reservedBytes(0), chunkNum(0)
+    {
+    }
+
+    /**
+     * @brief Arena析构函数
+     * 
+     * 一次释放全部内存块
+     * 
+     */
+    Arena::~Arena() {
+        Clear();
+    }
+
+    /**
+     * @brief 申请新的内存块
+     * 
+     * @param minSize 最小容量
+     */
+    void Arena::NewChunk(size_t minSize) {
+        size_t capacity = minSize > chunkSize ? minSize : chunkSize;
+        Chunk *chunk = (Chunk *)malloc(sizeof(Chunk) + capacity);
+        if (chunk == NULL) {
+            throw std::bad_alloc();
+        }
+        chunk->prev = current;
+        chunk->capacity = capacity;
+        current = chunk;
+        pos = (char *)(chunk + 1);
+        end = pos + capacity;
+        reservedBytes += sizeof(Chunk) + capacity;
+        chunkNum ++;
+    }
+
+    /**
+     * @brief 扩展最近一次分配
+     * 
+     * ptr须为最近一次分配的内存时才能扩展:
+     * 当前内存块放得下时原地扩展; ptr是当前内存块中唯一的分配时重新分配该内存块
+     * 其余情况返回NULL, 由调用者另行分配
+     * 
+     * @param ptr 内存
+     * @param oldSize 原大小
+     * @param newSize 新大小
+     * @param align 对齐(字节, 2的幂, 与分配时一致)
+     * @return 扩展后的内存(内容保留, 可能移动), 不能扩展时为NULL
+     */
+    void *Arena::Extend(void *ptr, size_t oldSize, size_t newSize, size_t align) {
+        char *p = (char *)ptr;
+        if (p == NULL || p + oldSize != pos || newSize < oldSize) {
+            return NULL;
+        }
+        if (p + newSize <= end) {
+            usedBytes += newSize - oldSize;
+            pos = p + newSize;
+            return p;
+        }
+        // ptr是当前内存块中唯一的分配, 整个内存块都属于它, 可以realloc
+        if (p != first) {
+            return NULL;
+        }
+        const size_t offset = p - (char *)(current + 1);
+        const size_t capacity = newSize + align;
+        Chunk *chunk = (Chunk *)realloc(current, sizeof(Chunk) + capacity);
+        if (chunk == NULL) {
+            throw std::bad_alloc();
+        }
+        reservedBytes += capacity - chunk->capacity;
+        usedBytes -= offset + oldSize;
+        chunk->capacity = capacity;
+        current = chunk;
+        char *start = (char *)(chunk + 1);
+        p = (char *)(((size_t)start + align - 1) & ~(align - 1));
+        if (p != start + offset) {
+            memmove(p, start + offset, oldSize);
+        }
+        end = start + capacity;
+        first = p;
+        pos = p + newSize;
+        usedBytes += pos - start;
+        return p;
+    }
+
+    /**
+     * @brief 复制字符串
+     * 
+     * @param str 字符串
+     * @param length 长度
+     * @return 以'\0'结尾的副本
+     */
+    const char *Arena::CopyString(const char *str, size_t length) {
+        char *copy = (char *)Allocate(length + 1, 1);
+        memcpy(copy, str, length);
+        copy[length] = '\0';
+        return copy;
+    }
+
+    /**
+     * @brief 释放全部内存
+     * 
+     */
+    void Arena::Clear() {
+        while (current != NULL) {
+            Chunk *prev = current->prev;
+            free(current);
+            current = prev;
+        }
+        pos = end = first = NULL;
+        usedBytes = reservedBytes = 0;
+        chunkNum = 0;
+    }
+
+    /**
+     * @brief 获取已分配字节数
+     * 
+     * @return 已分配字节数
+     */
+    const size_t Arena::GetUsedBytes() const {
+        return usedBytes;
+    }
+
+    /**
+     * @brief 获取已申请字节数
+     * 
+     * @return 已申请字节数
+     */
+    const size_t Arena::GetReservedBytes() const {
+        return reservedBytes;
+    }
+
+    /**
+     * @brief 获取内存块数
+     * 
+     * @return 内存块数
+     */
+    const int Arena::GetChunkNum() const {
+        return chunkNum;
+    }
+}
\ No newline at end of file
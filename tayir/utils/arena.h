@@ -0,0 +1,173 @@
+/**
+ * @file arena.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 单调内存池
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace tayir {
+    /**
+     * @brief 单调内存池
+     * 
+     * 从连续的内存块中顺序分配, 只能整体释放
+     * 放入其中的对象不会被析构
+     * 
+     */
+    class Arena {
+    protected:
+        /**
+         * @brief 内存块头
+         * 
+         */
+        struct Chunk {
+            /** 上一个内存块 */
+            Chunk *prev;
+            /** 内存块容量(不含头) */
+            size_t capacity;
+        };
+        /** 当前内存块 */
+        Chunk *current;
+        /** 当前内存块分配位置 */
+        char *pos;
+        /** 当前内存块末尾 */
+        char *end;
+        /** 当前内存块中的第一次分配 */
+        char *first;
+        /** 默认内存块大小 */
+        const size_t chunkSize;
+        /** 已分配字节数 */
+        size_t usedBytes;
+        /** 已申请字节数 */
+        size_t reservedBytes;
+        /** 内存块数 */
+        int chunkNum;
+        /**
+         * @brief 申请新的内存块
+         * 
+         * @param minSize 最小容量
+         */
+        void NewChunk(size_t minSize);
+    public:
+        /**
+         * @brief Arena构造函数
+         * 
+         * @param chunkSize 默认内存块大小
+         */
+        Arena(size_t chunkSize = 64 * 1024);
+        /**
+         * @brief 删除拷贝构造函数
+         * 
+         * @param other arena
+         */
+        Arena(const Arena &other) = delete;
+        /**
+         * @brief 删除默认赋值函数
+         * 
+         * @param other arena
+         * @return arena
+         */
+        Arena &operator=(const Arena &other) = delete;
+        /**
+         * @brief Arena析构函数
+         * 
+         * 一次释放全部内存块
+         * 
+         */
+        ~Arena();
+        /**
+         * @brief 分配内存
+         * 
+         * @param size 大小
+         * @param align 对齐(字节, 2的幂)
+         * @return 内存
+         */
+        void *Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+            char *p = (char *)(((size_t)pos + align - 1) & ~(align - 1));
+            if (p + size > end || pos == NULL) {
+                NewChunk(size + align);
+                p = (char *)(((size_t)pos + align - 1) & ~(align - 1));
+                first = p;
+            }
+            usedBytes += (p + size) - pos;
+            pos = p + size;
+            return p;
+        }
+        /**
+         * @brief 分配数组
+         * 
+         * @tparam T 元素类型
+         * @param num 元素数
+         * @return 数组
+         */
+        template<typename T> T *AllocateArray(size_t num) {
+            return (T *)Allocate(sizeof(T) * num, alignof(T));
+        }
+        /**
+         * @brief 在Arena中构造对象
+         * 
+         * @tparam T 对象类型
+         * @tparam Args 构造参数类型
+         * @param args 构造参数
+         * @return 对象
+         */
+        template<typename T, typename... Args> T *New(Args&&... args) {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        /**
+         * @brief 扩展最近一次分配
+         * 
+         * ptr须为最近一次分配的内存时才能扩展:
+         * 当前内存块放得下时原地扩展; ptr是当前内存块中唯一的分配时重新分配该内存块
+         * 其余情况返回NULL, 由调用者另行分配
+         * 
+         * @param ptr 内存
+         * @param oldSize 原大小
+         * @param newSize 新大小
+         * @param align 对齐(字节, 2的幂, 与分配时一致)
+         * @return 扩展后的内存(内容保留, 可能移动), 不能扩展时为NULL
+         */
+        void *Extend(void *ptr, size_t oldSize, size_t newSize, size_t align = alignof(std::max_align_t));
+        /**
+         * @brief 复制字符串
+         * 
+         * @param str 字符串
+         * @param length 长度
+         * @return 以'\0'结尾的副本
+         */
+        const char *CopyString(const char *str, size_t length);
+        /**
+         * @brief 释放全部内存
+         * 
+         */
+        void Clear();
+        /**
+         * @brief 获取已分配字节数
+         * 
+         * @return 已分配字节数
+         */
+        const size_t GetUsedBytes() const;
+        /**
+         * @brief 获取已申请字节数
+         * 
+         * @return 已申请字节数
+         */
+        const size_t GetReservedBytes() const;
+        /**
+         * @brief 获取内存块数
+         * 
+         * @return 内存块数
+         */
+        const int GetChunkNum() const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,332 @@
+/**
+ * @file bitset.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 位集
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <utils/bitset.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tayir {
+    /**
+     * @brief 申请存储
+     * 
+     */
+    void BitSet::Allocate() {
+        wordNum = (bitNum + WORD_BITS - 1) / WORD_BITS;
+        wordNum = (wordNum + WORD_ALIGN - 1) / WORD_ALIGN * WORD_ALIGN;
+        if (wordNum == 0) {
+            words = NULL;
+            return;
+        }
+        words = (qword *)std::aligned_alloc(32, sizeof(qword) * wordNum);
+        if (words == NULL) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /**
+     * @brief 检查大小是否相同
+     * 
+     * @param other 另一个位集
+     */
+    void BitSet::CheckSize(const BitSet &other) const {
+        if (bitNum != other.bitNum) {
+            //TODO: throw an exception instead of const char *
+            throw "Bit set size mismatch!";
+        }
+    }
+
+    /**
+     * @brief BitSet构造函数
+     * 
+     * 空集
+     * 
+     * @param bitNum 位数
+     */
+    BitSet::BitSet(int bitNum)
+        : bitNum(bitNum)
+    {
+        Allocate();
+        Clear();
+    }
+
+    /**
+     * @brief BitSet复制构造函数
+     * 
+     * @param other 另一个位集
+     */
+    BitSet::BitSet(const BitSet &other)
+        : bitNum(other.bitNum)
+    {
+        Allocate();
+        if (wordNum != 0) {
+            memcpy(words, other.words, sizeof(qword) * wordNum);
+        }
+    }
+
+    /**
+     * @brief BitSet移动构造函数
+     * 
+     * @param other 另一个位集
+     */
+    BitSet::BitSet(BitSet &&other)
+        : bitNum(other.bitNum), wordNum(other.wordNum), words(other.words)
+    {
+        other.bitNum = 0;
+        other.wordNum = 0;
+        other.words = NULL;
+    }
+
+    /**
+     * @brief 复制赋值
+     * 
+     * @param other 另一个位集
+     * @return 自身
+     */
+    BitSet &BitSet::operator=(const BitSet &other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (bitNum != other.bitNum) {
+            std::free(words);
+            bitNum = other.bitNum;
+            Allocate();
+        }
+        if (wordNum != 0) {
+            memcpy(words, other.words, sizeof(qword) * wordNum);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 移动赋值
+     * 
+     * @param other 另一个位集
+     * @return 自身
+     */
+    BitSet &BitSet::operator=(BitSet &&other) {
+        if (this == &other) {
+            return *this;
+        }
+        std::free(words);
+        bitNum = other.bitNum;
+        wordNum = other.wordNum;
+        words = other.words;
+        other.bitNum = 0;
+        other.wordNum = 0;
+        other.words = NULL;
+        return *this;
+    }
+
+    /**
+     * @brief BitSet析构函数
+     * 
+     */
+    BitSet::~BitSet() {
+        std::free(words);
+        words = NULL;
+    }
+
+    /**
+     * @brief 清空
+     * 
+     */
+    void BitSet::Clear() {
+        if (wordNum != 0) {
+            memset(words, 0, sizeof(qword) * wordNum);
+        }
+    }
+
+    /**
+     * @brief 置为全集
+     * 
+     */
+    void BitSet::Fill() {
+        if (wordNum == 0) {
+            return;
+        }
+        memset(words, 0xFF, sizeof(qword) * wordNum);
+        // 全集之外的位必须保持为0, 否则Count与迭代会出错
+        const int fullWords = bitNum / WORD_BITS;
+        if (bitNum % WORD_BITS != 0) {
+            words[fullWords] = (1ull << (bitNum % WORD_BITS)) - 1;
+            memset(words + fullWords + 1, 0, sizeof(qword) * (wordNum - fullWords - 1));
+        }
+        else {
+            memset(words + fullWords, 0, sizeof(qword) * (wordNum - fullWords));
+        }
+    }
+
+    /**
+     * @brief 并集
+     * 
+     * @param other 另一个位集
+     * @return 自身是否改变
+     */
+    bool BitSet::UnionWith(const BitSet &other) {
+        CheckSize(other);
+        qword *a = words;
+        const qword *b = other.words;
+#if defined(__AVX2__)
+        __m256i changed = _mm256_setzero_si256();
+        for (int i = 0 ; i < wordNum ; i += 4) {
+            __m256i x = _mm256_load_si256((const __m256i *)(a + i));
+            __m256i r = _mm256_or_si256(x, _mm256_load_si256((const __m256i *)(b + i)));
+            changed = _mm256_or_si256(changed, _mm256_xor_si256(r, x));
+            _mm256_store_si256((__m256i *)(a + i), r);
+        }
+        return ! _mm256_testz_si256(changed, changed);
+#elif defined(__SSE2__)
+        __m128i changed = _mm_setzero_si128();
+        for (int i = 0 ; i < wordNum ; i += 2) {
+            __m128i x = _mm_load_si128((const __m128i *)(a + i));
+            __m128i r = _mm_or_si128(x, _mm_load_si128((const __m128i *)(b + i)));
+            changed = _mm_or_si128(changed, _mm_xor_si128(r, x));
+            _mm_store_si128((__m128i *)(a + i), r);
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF;
+#else
+        qword changed = 0;
+        for (int i = 0 ; i < wordNum ; i ++) {
+            qword r = a[i] | b[i];
+            changed |= r ^ a[i];
+            a[i] = r;
+        }
+        return changed != 0;
+#endif
+    }
+
+    /**
+     * @brief 交集
+     * 
+     * @param other 另一个位集
+     * @return 自身是否改变
+     */
+    bool BitSet::IntersectWith(const BitSet &other) {
+        CheckSize(other);
+        qword *a = words;
+        const qword *b = other.words;
+#if defined(__AVX2__)
+        __m256i changed = _mm256_setzero_si256();
+        for (int i = 0 ; i < wordNum ; i += 4) {
+            __m256i x = _mm256_load_si256((const __m256i *)(a + i));
+            __m256i r = _mm256_and_si256(x, _mm256_load_si256((const __m256i *)(b + i)));
+            changed = _mm256_or_si256(changed, _mm256_xor_si256(r, x));
+            _mm256_store_si256((__m256i *)(a + i), r);
+        }
+        return ! _mm256_testz_si256(changed, changed);
+#elif defined(__SSE2__)
+        __m128i changed = _mm_setzero_si128();
+        for (int i = 0 ; i < wordNum ; i += 2) {
+            __m128i x = _mm_load_si128((const __m128i *)(a + i));
+            __m128i r = _mm_and_si128(x, _mm_load_si128((const __m128i *)(b + i)));
+            changed = _mm_or_si128(changed, _mm_xor_si128(r, x));
+            _mm_store_si128((__m128i *)(a + i), r);
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF;
+#else
+        qword changed = 0;
+        for (int i = 0 ; i < wordNum ; i ++) {
+            qword r = a[i] & b[i];
+            changed |= r ^ a[i];
+            a[i] = r;
+        }
+        return changed != 0;
+#endif
+    }
+
+    /**
+     * @brief 差集
+     * 
+     * @param other 另一个位集
+     * @return 自身是否改变
+     */
+    bool BitSet::DifferenceWith(const BitSet &other) {
+        CheckSize(other);
+        qword *a = words;
+        const qword *b = other.words;
+#if defined(__AVX2__)
+        __m256i changed = _mm256_setzero_si256();
+        for (int i = 0 ; i < wordNum ; i += 4) {
+            __m256i x = _mm256_load_si256((const __m256i *)(a + i));
+            __m256i r = _mm256_andnot_si256(_mm256_load_si256((const __m256i *)(b + i)), x);
+            changed = _mm256_or_si256(changed, _mm256_xor_si256(r, x));
+            _mm256_store_si256((__m256i *)(a + i), r);
+        }
+        return ! _mm256_testz_si256(changed, changed);
+#elif defined(__SSE2__)
+        __m128i changed = _mm_setzero_si128();
+        for (int i = 0 ; i < wordNum ; i += 2) {
+            __m128i x = _mm_load_si128((const __m128i *)(a + i));
+            __m128i r = _mm_andnot_si128(_mm_load_si128((const __m128i *)(b + i)), x);
+            changed = _mm_or_si128(changed, _mm_xor_si128(r, x));
+            _mm_store_si128((__m128i *)(a + i), r);
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) != 0xFFFF;
+#else
+        qword changed = 0;
+        for (int i = 0 ; i < wordNum ; i ++) {
+            qword r = a[i] & ~b[i];
+            changed |= r ^ a[i];
+            a[i] = r;
+        }
+        return changed != 0;
+#endif
+    }
+
+    /**
+     * @brief 获取元素数
+     * 
+     * @return 元素数
+     */
+    const int BitSet::Count() const {
+        int count = 0;
+        for (int i = 0 ; i < wordNum ; i ++) {
+            count += __builtin_popcountll(words[i]);
+        }
+        return count;
+    }
+
+    /**
+     * @brief 是否为空
+     * 
+     * @return 是否为空
+     */
+    const bool BitSet::IsEmpty() const {
+        for (int i = 0 ; i < wordNum ; i ++) {
+            if (words[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 判等
+     * 
+     * @param other 另一个位集
+     * @return 是否相等
+     */
+    bool BitSet::operator==(const BitSet &other) const {
+        if (bitNum != other.bitNum) {
+            return false;
+        }
+        return wordNum == 0 || memcmp(words, other.words, sizeof(qword) * wordNum) == 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+/**
+ * @file bitset.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 位集
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <utils/types.h>
+
+#include <cstddef>
+
+namespace tayir {
+    /**
+     * @brief 定长位集
+     * 
+     * 供数据流分析使用的稠密集合, 全集为[0, bitNum)
+     * 存储按32字节对齐并补齐到4个qword的整数倍, 集合运算在AVX2/SSE2下成块处理
+     * 参与运算的两个位集大小必须相同
+     * 
+     */
+    class BitSet {
+    protected:
+        /** 每个存储字的位数 */
+        static const int WORD_BITS = 64;
+        /** 存储字数的对齐(AVX2一次处理4个qword) */
+        static const int WORD_ALIGN = 4;
+        /** 位数 */
+        int bitNum;
+        /** 存储字数 */
+        int wordNum;
+        /** 存储 */
+        qword *words;
+        /**
+         * @brief 申请存储
+         * 
+         */
+        void Allocate();
+        /**
+         * @brief 检查大小是否相同
+         * 
+         * @param other 另一个位集
+         */
+        void CheckSize(const BitSet &other) const;
+    public:
+        /**
+         * @brief 位集迭代器
+         * 
+         * 按从小到大的顺序遍历集合中的元素, 每次前进只需一次ctz
+         * 
+         */
+        class Iterator {
+        protected:
+            /** 存储 */
+            const qword *words;
+            /** 存储字数 */
+            int wordNum;
+            /** 当前存储字下标 */
+            int wordSub;
+            /** 当前存储字中尚未遍历的位 */
+            qword rest;
+            /**
+             * @brief 跳过全零的存储字
+             * 
+             */
+            void SkipZeroWords() {
+                while (rest == 0 && wordSub < wordNum) {
+                    if (++ wordSub < wordNum) {
+                        rest = words[wordSub];
+                    }
+                }
+            }
+        public:
+            /**
+             * @brief Iterator构造函数
+             * 
+             * @param words 存储
+             * @param wordNum 存储字数
+             * @param wordSub 起始存储字下标
+             */
+            Iterator(const qword *words, int wordNum, int wordSub)
+                : words(words), wordNum(wordNum), wordSub(wordSub), rest(wordSub < wordNum ? words[wordSub] : 0)
+            {
+                SkipZeroWords();
+            }
+            /**
+             * @brief 获取元素
+             * 
+             * @return 元素
+             */
+            int operator*() const {
+                return wordSub * WORD_BITS + __builtin_ctzll(rest);
+            }
+            /**
+             * @brief 前进
+             * 
+             * @return 迭代器自身
+             */
+            Iterator &operator++() {
+                rest &= rest - 1;
+                SkipZeroWords();
+                return *this;
+            }
+            /**
+             * @brief 判不等
+             * 
+             * @param other 另一个迭代器
+             * @return 是否不等
+             */
+            bool operator!=(const Iterator &other) const {
+                return wordSub != other.wordSub || rest != other.rest;
+            }
+        };
+        /**
+         * @brief BitSet构造函数
+         * 
+         * 空集
+         * 
+         * @param bitNum 位数
+         */
+        BitSet(int bitNum = 0);
+        /**
+         * @brief BitSet复制构造函数
+         * 
+         * @param other 另一个位集
+         */
+        BitSet(const BitSet &other);
+        /**
+         * @brief BitSet移动构造函数
+         * 
+         * @param other 另一个位集
+         */
+        BitSet(BitSet &&other);
+        /**
+         * @brief 复制赋值
+         * 
+         * @param other 另一个位集
+         * @return 自身
+         */
+        BitSet &operator=(const BitSet &other);
+        /**
+         * @brief 移动赋值
+         * 
+         * @param other 另一个位集
+         * @return 自身
+         */
+        BitSet &operator=(BitSet &&other);
+        /**
+         * @brief BitSet析构函数
+         * 
+         */
+        ~BitSet();
+        /**
+         * @brief 获取位数
+         * 
+         * @return 位数
+         */
+        const int GetBitNum() const {
+            return bitNum;
+        }
+        /**
+         * @brief 是否包含元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 元素
+         * @return 是否包含
+         */
+        const bool Test(int sub) const {
+            return (words[sub / WORD_BITS] >> (sub % WORD_BITS)) & 1;
+        }
+        /**
+         * @brief 加入元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 元素
+         */
+        void Set(int sub) {
+            words[sub / WORD_BITS] |= 1ull << (sub % WORD_BITS);
+        }
+        /**
+         * @brief 移除元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 元素
+         */
+        void Reset(int sub) {
+            words[sub / WORD_BITS] &= ~(1ull << (sub % WORD_BITS));
+        }
+        /**
+         * @brief 清空
+         * 
+         */
+        void Clear();
+        /**
+         * @brief 置为全集
+         * 
+         */
+        void Fill();
+        /**
+         * @brief 并集
+         * 
+         * @param other 另一个位集
+         * @return 自身是否改变
+         */
+        bool UnionWith(const BitSet &other);
+        /**
+         * @brief 交集
+         * 
+         * @param other 另一个位集
+         * @return 自身是否改变
+         */
+        bool IntersectWith(const BitSet &other);
+        /**
+         * @brief 差集
+         * 
+         * @param other 另一个位集
+         * @return 自身是否改变
+         */
+        bool DifferenceWith(const BitSet &other);
+        /**
+         * @brief 获取元素数
+         * 
+         * @return 元素数
+         */
+        const int Count() const;
+        /**
+         * @brief 是否为空
+         * 
+         * @return 是否为空
+         */
+        const bool IsEmpty() const;
+        /**
+         * @brief 判等
+         * 
+         * @param other 另一个位集
+         * @return 是否相等
+         */
+        bool operator==(const BitSet &other) const;
+        /**
+         * @brief 判不等
+         * 
+         * @param other 另一个位集
+         * @return 是否不等
+         */
+        bool operator!=(const BitSet &other) const {
+            return ! (*this == other);
+        }
+        /**
+         * @brief 获取首元素迭代器
+         * 
+         * @return 迭代器
+         */
+        Iterator begin() const {
+            return Iterator(words, wordNum, 0);
+        }
+        /**
+         * @brief 获取尾后迭代器
+         * 
+         * @return 迭代器
+         */
+        Iterator end() const {
+            return Iterator(words, wordNum, wordNum);
+        }
+    };
+}
\ No newline at end of file
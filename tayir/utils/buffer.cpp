@@ -11,224 +11,307 @@
  */
 
 #include <utils/buffer.h>
+#include <cstdlib>
+#include <sys/mman.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace tayir {
-    /**
-     * @brief Byte Buffer构造函数
-     * 
-     * @param size 大小
-     * @param bigOrder 大端序
-     */
-    ByteBuffer::ByteBuffer(int size, bool bigOrder) 
-        : Buffer(size), bigOrder(bigOrder)
-    {
-    }
-
-    /**
-     * @brief 写字节
-     * 
-     * @param val 字节
-     */
-    void ByteBuffer::WriteByte(byte val) {
-        Write(val);
-    }
+    /** 大页大小 */
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
 
     /**
-     * @brief 写字
+     * @brief 分配缓存存储
      * 
-     * @param val 字
+     * @param bytes 请求字节数
+     * @param storage 存储方式
+     * @param arena 内存池(ARENA方式)
+     * @param capacity 实际可用字节数
+     * @return 存储
      */
-    void ByteBuffer::WriteWord(word val) {
-        if (bigOrder) {
-            Write((val >> 8) & 0xFF);
-            Write(val & 0xFF);
+    void *AllocateBufferStorage(size_t bytes, BufferStorage storage, Arena *arena, size_t &capacity) {
+        void *ptr = NULL;
+        switch (storage) {
+        case BufferStorage::HEAP:
+            capacity = bytes;
+            ptr = new byte[bytes];
+            break;
+        case BufferStorage::ALIGNED:
+            capacity = (bytes + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+            ptr = aligned_alloc(BUFFER_ALIGN, capacity);
+            break;
+        case BufferStorage::HUGE_PAGE:
+            capacity = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            ptr = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr == MAP_FAILED) {
+                // 未预留大页时退回普通映射, 请求透明大页
+                ptr = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED) {
+                    ptr = NULL;
+                    break;
+                }
+                madvise(ptr, capacity, MADV_HUGEPAGE);
+            }
+            break;
+        case BufferStorage::ARENA:
+            capacity = (bytes + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+            ptr = arena->Allocate(capacity, BUFFER_ALIGN);
+            break;
+        case BufferStorage::VIEW:
+            break;
         }
-        else {
-            Write(val & 0xFF);
-            Write((val >> 8) & 0xFF);
+        if (ptr == NULL) {
+            //TODO: throw an exception instead of const char *
+            throw "Out of memory!";
         }
+        return ptr;
     }
 
     /**
-     * @brief 写双字
+     * @brief 释放缓存存储
      * 
-     * @param val 双字
+     * @param ptr 存储
+     * @param capacity 实际可用字节数
+     * @param storage 存储方式
      */
-    void ByteBuffer::WriteDword(dword val) {
-        if (bigOrder) {
-            Write((val >> 24) & 0xFF);
-            Write((val >> 16) & 0xFF);
-            Write((val >> 8) & 0xFF);
-            Write(val & 0xFF);
-        }
-        else {
-            Write(val & 0xFF);
-            Write((val >> 8) & 0xFF);
-            Write((val >> 16) & 0xFF);
-            Write((val >> 24) & 0xFF);
+    void FreeBufferStorage(void *ptr, size_t capacity, BufferStorage storage) {
+        switch (storage) {
+        case BufferStorage::HEAP:
+            delete[] (byte *)ptr;
+            break;
+        case BufferStorage::ALIGNED:
+            free(ptr);
+            break;
+        case BufferStorage::HUGE_PAGE:
+            munmap(ptr, capacity);
+            break;
+        case BufferStorage::ARENA:
+        case BufferStorage::VIEW:
+            // 随Arena一同释放, 或不持有内存
+            break;
         }
     }
 
     /**
-     * @brief 写四字
+     * @brief 原地扩展缓存存储
      * 
-     * @param val 四字
+     * 仅ARENA方式, 且存储是Arena最近一次分配时可行
+     * 
+     * @param ptr 存储
+     * @param oldCapacity 原实际可用字节数
+     * @param bytes 请求字节数
+     * @param storage 存储方式
+     * @param arena 内存池(ARENA方式)
+     * @param capacity 实际可用字节数
+     * @return 扩展后的存储(内容保留), 不能扩展时为NULL
      */
-    void ByteBuffer::WriteQword(qword val) {
-        if (bigOrder) {
-            Write((val >> 56) & 0xFF);
-            Write((val >> 48) & 0xFF);
-            Write((val >> 40) & 0xFF);
-            Write((val >> 32) & 0xFF);
-            Write((val >> 24) & 0xFF);
-            Write((val >> 16) & 0xFF);
-            Write((val >> 8) & 0xFF);
-            Write(val & 0xFF);
-        }
-        else {
-            Write(val & 0xFF);
-            Write((val >> 8) & 0xFF);
-            Write((val >> 16) & 0xFF);
-            Write((val >> 24) & 0xFF);
-            Write((val >> 32) & 0xFF);
-            Write((val >> 40) & 0xFF);
-            Write((val >> 48) & 0xFF);
-            Write((val >> 56) & 0xFF);
+    void *ExtendBufferStorage(void *ptr, size_t oldCapacity, size_t bytes, BufferStorage storage, Arena *arena, size_t &capacity) {
+        if (storage != BufferStorage::ARENA) {
+            return NULL;
         }
+        capacity = (bytes + BUFFER_ALIGN - 1) & ~(BUFFER_ALIGN - 1);
+        return arena->Extend(ptr, oldCapacity, capacity, BUFFER_ALIGN);
     }
 
     /**
-     * @brief 写字符
+     * @brief 合并变长整数各字节的低7位
      * 
-     * @param val 字符
+     * @param bytes 变长整数的字节(小端, 已去掉后续字节, 不超过8字节)
+     * @return 值
      */
-    void ByteBuffer::WriteChar(char val) {
-        WriteByte(val);
+    static inline qword CompactVarint(qword bytes) {
+#if defined(__BMI2__)
+        return _pext_u64(bytes, 0x7F7F7F7F7F7F7F7Full);
+#else
+        bytes &= 0x7F7F7F7F7F7F7F7Full;
+        bytes = (bytes & 0x007F007F007F007Full) | ((bytes & 0x7F007F007F007F00ull) >> 1);
+        bytes = (bytes & 0x00003FFF00003FFFull) | ((bytes & 0x3FFF00003FFF0000ull) >> 2);
+        return (bytes & 0x000000000FFFFFFFull) | ((bytes & 0x0FFFFFFF00000000ull) >> 4);
+#endif
     }
 
     /**
-     * @brief 写短整型
+     * @brief 批量读无符号变长整数
      * 
-     * @param val 短整型
-     */
-    void ByteBuffer::WriteShort(short val) {
-        WriteWord(*(word *)&val);
-    }
-
-    /**
-     * @brief 写整型
+     * 剩余字节足够时:
+     * 16字节均无后续标记(SSE2或两个8字节字检查)则一次解码16个单字节整数,
+     * 否则解码8字节窗口内所有完整的整数, 各自用PEXT(或等价的位运算)合并
+     * 其余情况逐字节解码
      * 
-     * @param val 整型
+     * @param vals 无符号整数
      */
-    void ByteBuffer::WriteInt(int val) {
-        WriteDword(*(dword *)&val);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::ReadVarUs(Span<qword> vals) {
+        const byte *src = buffer + readPos;
+        const byte *end = buffer + writePos;
+        const size_t num = vals.GetSize();
+        size_t sub = 0;
+        while (sub < num) {
+            if (end - src >= 16) {
+#if defined(__SSE2__)
+                const __m128i chunk = _mm_loadu_si128((const __m128i *)src);
+                const bool allSingle = _mm_movemask_epi8(chunk) == 0;
+#else
+                qword halves[2];
+                memcpy(halves, src, sizeof(halves));
+                const bool allSingle = ((halves[0] | halves[1]) & 0x8080808080808080ull) == 0;
+#endif
+                if (num - sub >= 16 && allSingle) {
+                    for (int i = 0 ; i < 16 ; i ++) {
+                        vals[sub + i] = src[i];
+                    }
+                    src += 16;
+                    sub += 16;
+                    continue;
+                }
+                qword window;
+                memcpy(&window, src, sizeof(window));
+                qword stops = ~window & 0x8080808080808080ull;
+                if (stops != 0) {
+                    // 解码窗口内所有完整的整数
+                    int consumed = 0;
+                    while (stops != 0 && sub < num) {
+                        const int stop = (__builtin_ctzll(stops) >> 3) + 1;
+                        const int len = stop - consumed;
+                        const qword bytes = window >> (consumed * 8);
+                        vals[sub ++] = CompactVarint(len == 8 ? bytes : bytes & ((1ull << (len * 8)) - 1));
+                        consumed = stop;
+                        stops &= stops - 1;
+                    }
+                    src += consumed;
+                    continue;
+                }
+            }
+            qword val = 0;
+            for (int shift = 0 ; ; shift += 7) {
+                if (src >= end || shift >= 7 * VARINT_MAX_BYTES) {
+                    //TODO: throw an exception instead of const char *
+                    throw "Malformed varint!";
+                }
+                const byte unit = *src ++;
+                val |= (qword)(unit & 0x7F) << shift;
+                if ((unit & 0x80) == 0) {
+                    break;
+                }
+            }
+            vals[sub ++] = val;
+        }
+        readPos = src - buffer;
     }
 
     /**
-     * @brief 写超长整型
+     * @brief 批量读有符号变长整数
      * 
-     * @param val 超长整型
+     * @param vals 有符号整数
      */
-    void ByteBuffer::WriteLongLong(long long val) {
-        WriteQword(*(qword *)&val);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::ReadVarSs(Span<long long> vals) {
+        Span<qword> raw((qword *)vals.GetData(), vals.GetSize());
+        ReadVarUs(raw);
+        for (size_t i = 0 ; i < raw.GetSize() ; i ++) {
+            vals[i] = ZigZagDecode(raw[i]);
+        }
     }
 
     /**
-     * @brief 读字节
+     * @brief 写数组
+     * 
+     * 只做一次边界检查; 字节序与本机相同时直接复制
      * 
-     * @return 字节
+     * @tparam T 无符号整型
+     * @param vals 数组
      */
-    byte ByteBuffer::ReadByte() {
-        return Read();
+    template<ByteOrder Order> template<typename T> void BasicByteBuffer<Order>::WriteArray(Span<const T> vals) {
+        byte *dst = Claim(sizeof(T) * (int)vals.GetSize());
+        if constexpr (Order == ByteOrder::NATIVE) {
+            memcpy(dst, vals.GetData(), sizeof(T) * vals.GetSize());
+        }
+        else {
+            for (size_t i = 0 ; i < vals.GetSize() ; i ++) {
+                const T val = ByteSwap(vals[i]);
+                memcpy(dst + sizeof(T) * i, &val, sizeof(T));
+            }
+        }
     }
 
     /**
-     * @brief 读字
+     * @brief 读数组
+     * 
+     * 只做一次边界检查; 字节序与本机相同时直接复制
      * 
-     * @return 字
+     * @tparam T 无符号整型
+     * @param vals 数组
      */
-    word ByteBuffer::ReadWord() {
-        word byte1 = Read() & 0xFF;
-        word byte2 = Read() & 0xFF;
-        if (bigOrder) {
-            return ((byte2 << 8) | byte1);
+    template<ByteOrder Order> template<typename T> void BasicByteBuffer<Order>::ReadArray(Span<T> vals) {
+        const byte *src = Consume(sizeof(T) * (int)vals.GetSize());
+        if constexpr (Order == ByteOrder::NATIVE) {
+            memcpy(vals.GetData(), src, sizeof(T) * vals.GetSize());
+        }
+        else {
+            for (size_t i = 0 ; i < vals.GetSize() ; i ++) {
+                T val;
+                memcpy(&val, src + sizeof(T) * i, sizeof(T));
+                vals[i] = ByteSwap(val);
+            }
         }
-        return ((byte1 << 8) | byte2);
     }
-    
+
     /**
-     * @brief 读双字
+     * @brief 写字数组
      * 
-     * @return 双字
+     * @param vals 字数组
      */
-    dword ByteBuffer::ReadDword() {
-        dword byte1 = Read() & 0xFF;
-        dword byte2 = Read() & 0xFF;
-        dword byte3 = Read() & 0xFF;
-        dword byte4 = Read() & 0xFF;
-        if (bigOrder) {
-            return ((byte4 << 24) |(byte3 << 16) | (byte2 << 8) | byte1);
-        }
-        return ((byte1 << 24) |(byte2 << 16) | (byte3 << 8) | byte4);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::WriteWords(Span<const word> vals) {
+        WriteArray(vals);
     }
 
     /**
-     * @brief 读四字
+     * @brief 写双字数组
      * 
-     * @return 四字
+     * @param vals 双字数组
      */
-    qword ByteBuffer::ReadQword(){
-        qword byte1 = Read() & 0xFF;
-        qword byte2 = Read() & 0xFF;
-        qword byte3 = Read() & 0xFF;
-        qword byte4 = Read() & 0xFF;
-        qword byte5 = Read() & 0xFF;
-        qword byte6 = Read() & 0xFF;
-        qword byte7 = Read() & 0xFF;
-        qword byte8 = Read() & 0xFF;
-        if (bigOrder) {
-            return ((byte8 << 56) | (byte7 << 48) | (byte6 << 40) | (byte5 << 32) | (byte4 << 24) |(byte3 << 16) | (byte2 << 8) | byte1);
-        }
-        return ((byte1 << 56) | (byte2 << 48) | (byte3 << 40) | (byte4 << 32) | (byte5 << 24) |(byte6 << 16) | (byte7 << 8) | byte8);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::WriteDwords(Span<const dword> vals) {
+        WriteArray(vals);
     }
 
     /**
-     * @brief 读字符
+     * @brief 写四字数组
      * 
-     * @return 字符
+     * @param vals 四字数组
      */
-    char ByteBuffer::ReadChar() {
-        byte res = ReadByte();
-        return *(char *)(&res);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::WriteQwords(Span<const qword> vals) {
+        WriteArray(vals);
     }
 
     /**
-     * @brief 读短整型
+     * @brief 读字数组
      * 
-     * @return 短整型
+     * @param vals 字数组
      */
-    short ByteBuffer::ReadShort() {
-        word res = ReadWord();
-        return *(short *)(&res);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::ReadWords(Span<word> vals) {
+        ReadArray(vals);
     }
 
     /**
-     * @brief 读整型
+     * @brief 读双字数组
      * 
-     * @return 整型
+     * @param vals 双字数组
      */
-    int ByteBuffer::ReadInt() {
-        dword res = ReadDword();
-        return *(int *)(&res);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::ReadDwords(Span<dword> vals) {
+        ReadArray(vals);
     }
 
     /**
-     * @brief 读超长整型
+     * @brief 读四字数组
      * 
-     * @return 超长整型
+     * @param vals 四字数组
      */
-    long long ByteBuffer::ReadLongLong() {
-        qword res = ReadQword();
-        return *(long long *)(&res);
+    template<ByteOrder Order> void BasicByteBuffer<Order>::ReadQwords(Span<qword> vals) {
+        ReadArray(vals);
     }
+
+    template class BasicByteBuffer<ByteOrder::LITTLE>;
+    template class BasicByteBuffer<ByteOrder::BIG>;
 }
\ No newline at end of file
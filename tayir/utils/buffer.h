@@ -13,56 +13,195 @@
 #pragma once
 
 #include <utils/types.h>
+#include <utils/span.h>
+#include <utils/arena.h>
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
 
 namespace tayir {
+    /**
+     * @brief 缓存存储方式
+     * 
+     */
+    enum class BufferStorage {
+        /** 普通堆内存 */
+        HEAP      = 0,
+        /** 按缓存行(64字节)对齐的堆内存 */
+        ALIGNED   = 1,
+        /** 匿名映射, 优先使用大页(MAP_HUGETLB), 失败时退回madvise */
+        HUGE_PAGE = 2,
+        /** 从Arena分配, 随Arena一同释放; 缓存是Arena最近一次分配时原地扩容, 否则旧存储留在Arena中 */
+        ARENA     = 3,
+        /** 只读视图, 不持有内存也不能扩容 */
+        VIEW      = 4
+    };
+
+    /** 缓存对齐 */
+    static const size_t BUFFER_ALIGN = 64;
+
+    /**
+     * @brief 分配缓存存储
+     * 
+     * @param bytes 请求字节数
+     * @param storage 存储方式
+     * @param arena 内存池(ARENA方式)
+     * @param capacity 实际可用字节数
+     * @return 存储
+     */
+    void *AllocateBufferStorage(size_t bytes, BufferStorage storage, Arena *arena, size_t &capacity);
+
+    /**
+     * @brief 释放缓存存储
+     * 
+     * @param ptr 存储
+     * @param capacity 实际可用字节数
+     * @param storage 存储方式
+     */
+    void FreeBufferStorage(void *ptr, size_t capacity, BufferStorage storage);
+
+    /**
+     * @brief 原地扩展缓存存储
+     * 
+     * 仅ARENA方式, 且存储是Arena最近一次分配时可行
+     * 
+     * @param ptr 存储
+     * @param oldCapacity 原实际可用字节数
+     * @param bytes 请求字节数
+     * @param storage 存储方式
+     * @param arena 内存池(ARENA方式)
+     * @param capacity 实际可用字节数
+     * @return 扩展后的存储(内容保留), 不能扩展时为NULL
+     */
+    void *ExtendBufferStorage(void *ptr, size_t oldCapacity, size_t bytes, BufferStorage storage, Arena *arena, size_t &capacity);
+
     /**
      * @brief 缓存
      * 
-     * @tparam UnitType 单元类型
+     * 写满时按两倍扩容
+     * 
+     * @tparam UnitType 单元类型(须可平凡复制)
      */
     template<typename UnitType> class Buffer {
+        static_assert(std::is_trivially_copyable<UnitType>::value, "Buffer unit must be trivially copyable");
     protected:
+        /**
+         * @brief 检查是否可写
+         * 
+         * 只读视图(如映射的文件)不可写
+         * 
+         */
+        void CheckWritable() const {
+            if (storage == BufferStorage::VIEW) {
+                //TODO: throw an exception instead of const char *
+                throw "Can't write to a buffer view!";
+            }
+        }
         /** 读指针 */
         int readPos;
-        /** 读指针 */
+        /** 写指针 */
         int writePos;
-        /** 大小 */
+        /** 容量 */
         int size;
+        /** 存储方式 */
+        const BufferStorage storage;
+        /** 内存池(ARENA方式) */
+        Arena *const arena;
+        /** 存储实际字节数 */
+        size_t storageBytes;
         /** 缓存 */
         UnitType *buffer;
+        /**
+         * @brief 扩容
+         * 
+         * @param num 最小容量
+         */
+        void Grow(int num) {
+            if (num < 0) {
+                //TODO: throw an exception instead of const char *
+                throw "Buffer too large!";
+            }
+            CheckWritable();
+            size_t capacity;
+            if (buffer != NULL) {
+                UnitType *extended = (UnitType *)ExtendBufferStorage(buffer, storageBytes, sizeof(UnitType) * num, storage, arena, capacity);
+                if (extended != NULL) {
+                    buffer = extended;
+                    storageBytes = capacity;
+                    size = capacity / sizeof(UnitType) > 0x7FFFFFFF ? 0x7FFFFFFF : capacity / sizeof(UnitType);
+                    return;
+                }
+            }
+            UnitType *newBuffer = (UnitType *)AllocateBufferStorage(sizeof(UnitType) * num, storage, arena, capacity);
+            if (writePos > 0) {
+                memcpy(newBuffer, buffer, sizeof(UnitType) * writePos);
+            }
+            if (buffer != NULL) {
+                FreeBufferStorage(buffer, storageBytes, storage);
+            }
+            buffer = newBuffer;
+            storageBytes = capacity;
+            size = capacity / sizeof(UnitType) > 0x7FFFFFFF ? 0x7FFFFFFF : capacity / sizeof(UnitType);
+        }
     public:
         /**
          * @brief Buffer构造函数
          * 
-         * @param size Buffer大小
+         * @param size 初始容量
+         * @param storage 存储方式
+         * @param arena 内存池(ARENA方式)
          */
-        Buffer(int size)
-            : readPos(0), writePos(0), size(size), buffer(new UnitType[size])
+        Buffer(int size, BufferStorage storage = BufferStorage::HEAP, Arena *arena = NULL)
+            : readPos(0), writePos(0), size(0), storage(storage), arena(arena), storageBytes(0), buffer(NULL)
         {
+            if (storage == BufferStorage::ARENA && arena == NULL) {
+                //TODO: throw an exception instead of const char *
+                throw "Arena buffer without arena!";
+            }
+            Grow(size > 0 ? size : 1);
         }
+        /**
+         * @brief Buffer构造函数
+         * 
+         * 构造只读视图, 可读内容为给定的数据
+         * 
+         * @param data 数据(须比视图存活更久)
+         * @param num 数量
+         */
+        Buffer(const UnitType *data, int num)
+            : readPos(0), writePos(num), size(num), storage(BufferStorage::VIEW), arena(NULL), storageBytes(0),
+              buffer(const_cast<UnitType *>(data))
+        {
+        }
+        Buffer(const Buffer &other) = delete;
+        Buffer &operator=(const Buffer &other) = delete;
         /**
          * @brief Buffer析构函数
          * 
          */
         virtual ~Buffer() {
             if (buffer != NULL) {
-                delete buffer;
+                FreeBufferStorage(buffer, storageBytes, storage);
                 buffer = NULL;
             }
         }
+        /**
+         * @brief 预留容量
+         * 
+         * @param num 最小容量
+         */
+        void Reserve(int num) {
+            if (num > size) {
+                Grow(num);
+            }
+        }
         /**
          * @brief 写
          * 
          * @param unit 要写的值
          */
         void Write(UnitType unit) {
-            if (writePos >= size || writePos < 0) {
-                //TODO
-                throw "exception";
-            }
-            buffer[writePos] = unit;
-            writePos ++;
+            *Claim(1) = unit;
         }
         /**
          * @brief 读
@@ -70,135 +209,583 @@ namespace tayir {
          * @return 读到的值
          */
         UnitType Read(void) {
-            if (readPos >= writePos || readPos < 0) {
-                //TODO
-                throw "exception";
+            return *Consume(1);
+        }
+        /**
+         * @brief 批量写
+         * 
+         * 只做一次边界检查
+         * 
+         * @param units 要写的值
+         * @param num 数量
+         */
+        void WriteUnits(const UnitType *units, int num) {
+            memcpy(Claim(num), units, sizeof(UnitType) * num);
+        }
+        /**
+         * @brief 批量读
+         * 
+         * 只做一次边界检查
+         * 
+         * @param units 读到的值
+         * @param num 数量
+         */
+        void ReadUnits(UnitType *units, int num) {
+            memcpy(units, Consume(num), sizeof(UnitType) * num);
+        }
+        /**
+         * @brief 占用写空间
+         * 
+         * 容量不足时扩容并移动写指针, 调用者可直接写入返回的位置
+         * 返回的指针在下一次扩容前有效, 只读视图不可占用
+         * 
+         * @param num 数量
+         * @return 占用空间的起始位置
+         */
+        UnitType *Claim(int num) {
+            CheckWritable();
+            if (num < 0) {
+                //TODO: throw an exception instead of const char *
+                throw "Out of boundary!";
+            }
+            if (num > size - writePos) {
+                int capacity = writePos + num;
+                if (size <= 0x3FFFFFFF && size * 2 > capacity) {
+                    capacity = size * 2;
+                }
+                Grow(capacity);
+            }
+            writePos += num;
+            return buffer + writePos - num;
+        }
+        /**
+         * @brief 消耗读空间
+         * 
+         * 检查边界并移动读指针
+         * 
+         * @param num 数量
+         * @return 消耗空间的起始位置
+         */
+        const UnitType *Consume(int num) {
+            if (num < 0 || num > writePos - readPos) {
+                //TODO: throw an exception instead of const char *
+                throw "Out of boundary!";
+            }
+            readPos += num;
+            return buffer + readPos - num;
+        }
+        /**
+         * @brief 获取数据
+         * 
+         * 只读视图只能通过const版本获取
+         * 
+         * @return 数据
+         */
+        UnitType *GetData() {
+            CheckWritable();
+            return buffer;
+        }
+        /**
+         * @brief 获取数据
+         * 
+         * @return 数据
+         */
+        const UnitType *GetData() const {
+            return buffer;
+        }
+        /**
+         * @brief 获取已写数量
+         * 
+         * @return 已写数量
+         */
+        const int GetWritePos() const {
+            return writePos;
+        }
+        /**
+         * @brief 获取已读数量
+         * 
+         * @return 已读数量
+         */
+        const int GetReadPos() const {
+            return readPos;
+        }
+        /**
+         * @brief 获取容量
+         * 
+         * @return 容量
+         */
+        const int GetCapacity() const {
+            return size;
+        }
+        /**
+         * @brief 获取存储方式
+         * 
+         * @return 存储方式
+         */
+        const BufferStorage GetStorage() const {
+            return storage;
+        }
+        /**
+         * @brief 移动读指针
+         * 
+         * @param pos 新的读指针(不超过已写数量)
+         */
+        void Seek(int pos) {
+            if (pos < 0 || pos > writePos) {
+                //TODO: throw an exception instead of const char *
+                throw "Out of boundary!";
             }
-            readPos ++;
-            return buffer[readPos - 1];
+            readPos = pos;
+        }
+        /**
+         * @brief 回到开头重新读
+         * 
+         */
+        void Rewind() {
+            readPos = 0;
         }
         /**
          * @brief 重置
          * 
+         * 只读视图不可重置, 只能Rewind
+         * 
          */
         void Reset() {
+            CheckWritable();
             readPos = writePos = 0;
         }
     };
 
+    /**
+     * @brief 字节序
+     * 
+     */
+    enum class ByteOrder {
+        /** 小端序 */
+        LITTLE,
+        /** 大端序 */
+        BIG,
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        /** 本机字节序 */
+        NATIVE = BIG
+#else
+        /** 本机字节序 */
+        NATIVE = LITTLE
+#endif
+    };
+
+    /**
+     * @brief 交换字节序
+     * 
+     * @param val 值
+     * @return 结果
+     */
+    inline byte ByteSwap(byte val) {
+        return val;
+    }
+
+    /**
+     * @brief 交换字节序
+     * 
+     * @param val 值
+     * @return 结果
+     */
+    inline word ByteSwap(word val) {
+        return __builtin_bswap16(val);
+    }
+
+    /**
+     * @brief 交换字节序
+     * 
+     * @param val 值
+     * @return 结果
+     */
+    inline dword ByteSwap(dword val) {
+        return __builtin_bswap32(val);
+    }
+
+    /**
+     * @brief 交换字节序
+     * 
+     * @param val 值
+     * @return 结果
+     */
+    inline qword ByteSwap(qword val) {
+        return __builtin_bswap64(val);
+    }
+
+    /**
+     * @brief 在本机字节序与指定字节序之间转换
+     * 
+     * 转换是对称的, 读写共用
+     * 
+     * @tparam Order 字节序
+     * @tparam T 无符号整型
+     * @param val 值
+     * @return 结果
+     */
+    template<ByteOrder Order, typename T> inline T ConvertOrder(T val) {
+        if constexpr (Order == ByteOrder::NATIVE) {
+            return val;
+        }
+        else {
+            return ByteSwap(val);
+        }
+    }
+
+    /**
+     * @brief zigzag编码
+     * 
+     * 将绝对值小的有符号数映射为小的无符号数: 0, -1, 1, -2 ... -> 0, 1, 2, 3 ...
+     * 
+     * @param val 有符号数
+     * @return 无符号数
+     */
+    inline qword ZigZagEncode(long long val) {
+        return ((qword)val << 1) ^ (qword)(val >> 63);
+    }
+
+    /**
+     * @brief zigzag解码
+     * 
+     * @param val 无符号数
+     * @return 有符号数
+     */
+    inline long long ZigZagDecode(qword val) {
+        return (long long)((val >> 1) ^ (~(val & 1) + 1));
+    }
+
+    /** 变长整数最大字节数 */
+    static const int VARINT_MAX_BYTES = 10;
+
     /**
      * @brief 字节Buffer
      * 
+     * 字节序在编译期确定, 多字节读写各只做一次边界检查
+     * 
+     * @tparam Order 字节序
      */
-    class ByteBuffer : public Buffer<byte> {
+    template<ByteOrder Order> class BasicByteBuffer : public Buffer<byte> {
+    protected:
+        /**
+         * @brief 写值
+         * 
+         * @tparam T 无符号整型
+         * @param val 值
+         */
+        template<typename T> void WriteValue(T val) {
+            val = ConvertOrder<Order>(val);
+            memcpy(Claim(sizeof(T)), &val, sizeof(T));
+        }
+        /**
+         * @brief 读值
+         * 
+         * @tparam T 无符号整型
+         * @return 值
+         */
+        template<typename T> T ReadValue() {
+            T val;
+            memcpy(&val, Consume(sizeof(T)), sizeof(T));
+            return ConvertOrder<Order>(val);
+        }
+        /**
+         * @brief 写数组
+         * 
+         * @tparam T 无符号整型
+         * @param vals 数组
+         */
+        template<typename T> void WriteArray(Span<const T> vals);
         /**
-         * @brief 大端序
+         * @brief 读数组
          * 
+         * @tparam T 无符号整型
+         * @param vals 数组
          */
-        bool bigOrder;
+        template<typename T> void ReadArray(Span<T> vals);
     public:
         /**
          * @brief Byte Buffer构造函数
          * 
-         * @param size 大小
-         * @param bigOrder 大端序
+         * @param size 初始容量
+         * @param storage 存储方式
+         * @param arena 内存池(ARENA方式)
+         */
+        BasicByteBuffer(int size, BufferStorage storage = BufferStorage::HEAP, Arena *arena = NULL)
+            : Buffer(size, storage, arena)
+        {
+        }
+        /**
+         * @brief Byte Buffer构造函数
+         * 
+         * 构造只读视图
+         * 
+         * @param data 数据(须比视图存活更久)
+         * @param num 字节数
          */
-        ByteBuffer(int size, bool bigOrder);
+        BasicByteBuffer(const void *data, int num)
+            : Buffer((const byte *)data, num)
+        {
+        }
+        /**
+         * @brief 写字节串
+         * 
+         * 原样写入, 不转换字节序
+         * 
+         * @param src 字节串
+         * @param num 字节数
+         */
+        void WriteBytes(const void *src, int num) {
+            WriteUnits((const byte *)src, num);
+        }
+        /**
+         * @brief 读字节串
+         * 
+         * 原样读出, 不转换字节序
+         * 
+         * @param dst 字节串
+         * @param num 字节数
+         */
+        void ReadBytes(void *dst, int num) {
+            ReadUnits((byte *)dst, num);
+        }
         /**
          * @brief 写字节
          * 
          * @param val 字节
          */
-        void WriteByte(byte val);
+        void WriteByte(byte val) {
+            Write(val);
+        }
         /**
          * @brief 写字
          * 
          * @param val 字
          */
-        void WriteWord(word val);
+        void WriteWord(word val) {
+            WriteValue(val);
+        }
         /**
          * @brief 写双字
          * 
          * @param val 双字
          */
-        void WriteDword(dword val);
+        void WriteDword(dword val) {
+            WriteValue(val);
+        }
         /**
          * @brief 写四字
          * 
          * @param val 四字
          */
-        void WriteQword(qword val);
+        void WriteQword(qword val) {
+            WriteValue(val);
+        }
         /**
          * @brief 写字符
          * 
          * @param val 字符
          */
-        void WriteChar(char val);
+        void WriteChar(char val) {
+            WriteByte((byte)val);
+        }
         /**
          * @brief 写短整型
          * 
          * @param val 短整型
          */
-        void WriteShort(short val);
+        void WriteShort(short val) {
+            WriteWord((word)val);
+        }
         /**
          * @brief 写整型
          * 
          * @param val 整型
          */
-        void WriteInt(int val);
+        void WriteInt(int val) {
+            WriteDword((dword)val);
+        }
         /**
          * @brief 写超长整型
          * 
          * @param val 超长整型
          */
-        void WriteLongLong(long long val);
+        void WriteLongLong(long long val) {
+            WriteQword((qword)val);
+        }
+        /**
+         * @brief 写无符号变长整数
+         * 
+         * LEB128编码: 每字节低7位为数据, 最高位表示后面还有字节
+         * 
+         * @param val 无符号整数
+         */
+        void WriteVarU(qword val) {
+            // 按最大长度占用, 写完后退回多占的部分
+            byte *dst = Claim(VARINT_MAX_BYTES);
+            int len = 0;
+            while (val >= 0x80) {
+                dst[len ++] = (byte)(val | 0x80);
+                val >>= 7;
+            }
+            dst[len ++] = (byte)val;
+            writePos -= VARINT_MAX_BYTES - len;
+        }
+        /**
+         * @brief 写有符号变长整数
+         * 
+         * zigzag编码后按LEB128写入
+         * 
+         * @param val 有符号整数
+         */
+        void WriteVarS(long long val) {
+            WriteVarU(ZigZagEncode(val));
+        }
+        /**
+         * @brief 写字数组
+         * 
+         * @param vals 字数组
+         */
+        void WriteWords(Span<const word> vals);
+        /**
+         * @brief 写双字数组
+         * 
+         * @param vals 双字数组
+         */
+        void WriteDwords(Span<const dword> vals);
+        /**
+         * @brief 写四字数组
+         * 
+         * @param vals 四字数组
+         */
+        void WriteQwords(Span<const qword> vals);
         /**
          * @brief 读字节
          * 
          * @return 字节
          */
-        byte ReadByte();
+        byte ReadByte() {
+            return Read();
+        }
         /**
          * @brief 读字
          * 
          * @return 字
          */
-        word ReadWord();
+        word ReadWord() {
+            return ReadValue<word>();
+        }
         /**
          * @brief 读双字
          * 
          * @return 双字
          */
-        dword ReadDword();
+        dword ReadDword() {
+            return ReadValue<dword>();
+        }
         /**
          * @brief 读四字
          * 
          * @return 四字
          */
-        qword ReadQword();
+        qword ReadQword() {
+            return ReadValue<qword>();
+        }
         /**
          * @brief 读字符
          * 
          * @return 字符
          */
-        char ReadChar();
+        char ReadChar() {
+            return (char)ReadByte();
+        }
         /**
          * @brief 读短整型
          * 
          * @return 短整型
          */
-        short ReadShort();
+        short ReadShort() {
+            return (short)ReadWord();
+        }
         /**
          * @brief 读整型
          * 
          * @return 整型
          */
-        int ReadInt();
+        int ReadInt() {
+            return (int)ReadDword();
+        }
         /**
          * @brief 读超长整型
          * 
          * @return 超长整型
          */
-        long long ReadLongLong();
+        long long ReadLongLong() {
+            return (long long)ReadQword();
+        }
+        /**
+         * @brief 读无符号变长整数
+         * 
+         * @return 无符号整数
+         */
+        qword ReadVarU() {
+            qword val = 0;
+            for (int shift = 0 ; shift < 7 * VARINT_MAX_BYTES ; shift += 7) {
+                const byte unit = Read();
+                val |= (qword)(unit & 0x7F) << shift;
+                if ((unit & 0x80) == 0) {
+                    return val;
+                }
+            }
+            //TODO: throw an exception instead of const char *
+            throw "Malformed varint!";
+        }
+        /**
+         * @brief 读有符号变长整数
+         * 
+         * @return 有符号整数
+         */
+        long long ReadVarS() {
+            return ZigZagDecode(ReadVarU());
+        }
+        /**
+         * @brief 批量读无符号变长整数
+         * 
+         * 一次迭代可解码多个单字节整数; 出错时读指针不变
+         * 
+         * @param vals 无符号整数
+         */
+        void ReadVarUs(Span<qword> vals);
+        /**
+         * @brief 批量读有符号变长整数
+         * 
+         * @param vals 有符号整数
+         */
+        void ReadVarSs(Span<long long> vals);
+        /**
+         * @brief 读字数组
+         * 
+         * @param vals 字数组
+         */
+        void ReadWords(Span<word> vals);
+        /**
+         * @brief 读双字数组
+         * 
+         * @param vals 双字数组
+         */
+        void ReadDwords(Span<dword> vals);
+        /**
+         * @brief 读四字数组
+         * 
+         * @param vals 四字数组
+         */
+        void ReadQwords(Span<qword> vals);
     };
+
+    /** 小端序字节Buffer */
+    typedef BasicByteBuffer<ByteOrder::LITTLE> ByteBuffer;
+    /** 大端序字节Buffer */
+    typedef BasicByteBuffer<ByteOrder::BIG> BigByteBuffer;
+
+    extern template class BasicByteBuffer<ByteOrder::LITTLE>;
+    extern template class BasicByteBuffer<ByteOrder::BIG>;
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * @file check.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 边界检查策略
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ * 默认(调试构建)下, 访问器越界时按各自的方式报告错误(抛出异常或返回错误值)
+ * 定义TAYIR_UNCHECKED(发布构建)后, 越界只由assert检查, 报告错误的分支被编译器消除;
+ * 同时定义NDEBUG时不产生任何检查代码
+ * 
+ */
+
+#pragma once
+
+#include <cassert>
+
+/**
+ * @brief 下标是否越界
+ * 
+ * 用法: if (TAYIR_OUT_OF_BOUND(sub, num)) { 报告错误 }
+ * 
+ * @param sub 下标
+ * @param num 元素数, 合法下标为[0, num)
+ */
+#if defined(TAYIR_UNCHECKED)
+#define TAYIR_OUT_OF_BOUND(sub, num) (assert((sub) >= 0 && (sub) < (num)), false)
+#else
+#define TAYIR_OUT_OF_BOUND(sub, num) ((sub) < 0 || (sub) >= (num))
+#endif
+
+/**
+ * @brief 有效性检查是否失败
+ * 
+ * 用于下标以外的检查(如句柄是否已被释放), 策略与TAYIR_OUT_OF_BOUND相同
+ * 用法: if (TAYIR_CHECK_FAILED(valid)) { 报告错误 }
+ * 
+ * @param cond 应当成立的条件
+ */
+#if defined(TAYIR_UNCHECKED)
+#define TAYIR_CHECK_FAILED(cond) (assert(cond), false)
+#else
+#define TAYIR_CHECK_FAILED(cond) (! (cond))
+#endif
\ No newline at end of file
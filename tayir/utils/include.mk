@@ -1 +1,6 @@
-objects += ./utils/buffer.o
\ No newline at end of file
+objects += ./utils/buffer.o
+objects += ./utils/arena.o
+objects += ./utils/interner.o
+objects += ./utils/bitset.o
+objects += ./utils/sparseset.o
+objects += ./utils/threadpool.o
\ No newline at end of file
@@ -0,0 +1,134 @@
+/**
+ * @file interner.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 字符串驻留
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <utils/interner.h>
+#include <algorithm>
+
+namespace tayir {
+    std::atomic<StringInterner *> StringInterner::current(NULL);
+
+    /**
+     * @brief StringInterner构造函数
+     * 
+     */
+    StringInterner::StringInterner() : stringNum(0) {
+        std::fill(chunks, chunks + INTERNER_CHUNK_MAX, (std::string_view *)NULL);
+        // 空字符串占用ID 0
+        Intern(std::string_view());
+    }
+
+    /**
+     * @brief StringInterner析构函数
+     * 
+     */
+    StringInterner::~StringInterner() {
+        for (std::string_view *chunk : chunks) {
+            delete[] chunk;
+        }
+    }
+
+    /**
+     * @brief 存储新字符串
+     * 
+     * @param str 字符串
+     * @return 名称ID与存储后的字符串
+     */
+    std::pair<NameId, std::string_view> StringInterner::Store(std::string_view str) {
+        std::lock_guard<std::mutex> guard(storageLock);
+        const NameId id = stringNum.load(std::memory_order_relaxed);
+        const int chunkSub = id >> INTERNER_CHUNK_SHIFT;
+        if (chunkSub >= INTERNER_CHUNK_MAX) {
+            //TODO: throw an exception instead of const char *
+            throw "Too many names!";
+        }
+        if (chunks[chunkSub] == NULL) {
+            chunks[chunkSub] = new std::string_view[1 << INTERNER_CHUNK_SHIFT];
+        }
+        std::string_view copy(str.empty() ? "" : arena.CopyString(str.data(), str.length()), str.length());
+        chunks[chunkSub][id & ((1 << INTERNER_CHUNK_SHIFT) - 1)] = copy;
+        stringNum.store(id + 1, std::memory_order_release);
+        return std::make_pair(id, copy);
+    }
+
+    /**
+     * @brief 驻留字符串
+     * 
+     * 线程安全
+     * 
+     * @param str 字符串
+     * @return 名称ID
+     */
+    NameId StringInterner::Intern(std::string_view str) {
+        if (str.empty() && stringNum.load(std::memory_order_acquire) != 0) {
+            return 0;
+        }
+        Shard &shard = shards[std::hash<std::string_view>()(str) % INTERNER_SHARD_NUM];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto iter = shard.index.find(str);
+        if (iter != shard.index.end()) {
+            return iter->second;
+        }
+        // 分片锁保证同一字符串只存储一次
+        const std::pair<NameId, std::string_view> stored = Store(str);
+        shard.index.insert(std::make_pair(stored.second, stored.first));
+        return stored.first;
+    }
+
+    /**
+     * @brief 获取字符串数
+     * 
+     * @return 字符串数
+     */
+    const int StringInterner::GetStringNum() const {
+        return stringNum.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 获取占用字节数
+     * 
+     * @return 占用字节数
+     */
+    const size_t StringInterner::GetArenaBytes() const {
+        return arena.GetReservedBytes();
+    }
+
+    /**
+     * @brief 获取全部占用字节数
+     * 
+     * 驻留表对象, 字符存储, 已分配的ID块与查找表; 查找表的节点按值加一个指针估算
+     * 不应与Intern同时调用
+     * 
+     * @return 占用字节数
+     */
+    const size_t StringInterner::GetReservedBytes() const {
+        size_t bytes = sizeof(StringInterner) + arena.GetReservedBytes();
+        for (std::string_view *chunk : chunks) {
+            if (chunk != NULL) {
+                bytes += sizeof(std::string_view) << INTERNER_CHUNK_SHIFT;
+            }
+        }
+        for (const Shard &shard : shards) {
+            bytes += sizeof(void *) * shard.index.bucket_count() + (sizeof(std::pair<const std::string_view, NameId>) + sizeof(void *)) * shard.index.size();
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief 获取全局驻留表
+     * 
+     * @return 全局驻留表
+     */
+    StringInterner &StringInterner::GetGlobal() {
+        static StringInterner global;
+        return global;
+    }
+}
\ No newline at end of file
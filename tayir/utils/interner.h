@@ -0,0 +1,327 @@
+/**
+ * @file interner.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 字符串驻留
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <utils/types.h>
+#include <utils/arena.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+
+namespace tayir {
+    /**
+     * @brief 名称ID
+     * 
+     */
+    typedef dword NameId;
+
+    /** 驻留表分片数 */
+    static const int INTERNER_SHARD_NUM = 64;
+    /** 驻留表每块字符串数(2^n) */
+    static const int INTERNER_CHUNK_SHIFT = 14;
+    /** 驻留表最大块数 */
+    static const int INTERNER_CHUNK_MAX = 1 << 14;
+
+    /**
+     * @brief 字符串驻留表
+     * 
+     * 每个不同的字符串只存储一份, 以32位ID标识
+     * ID 0 固定为空字符串
+     * 
+     * 可被多个线程同时使用:
+     * 查找表按哈希分片, 各分片单独加锁; 新字符串的存储另有一把锁
+     * ID -> 字符串表分块存放, 已分配的块不再移动, 因此GetString不加锁
+     * 
+     */
+    class StringInterner {
+    protected:
+        /**
+         * @brief 查找表分片
+         * 
+         */
+        struct alignas(64) Shard {
+            /** 分片锁 */
+            std::mutex lock;
+            /** 字符串 -> ID */
+            std::unordered_map<std::string_view, NameId> index;
+        };
+        /** 查找表分片 */
+        Shard shards[INTERNER_SHARD_NUM];
+        /** 存储锁(保护arena与chunks) */
+        std::mutex storageLock;
+        /** 字符存储 */
+        Arena arena;
+        /** ID -> 字符串, 分块存放 */
+        std::string_view *chunks[INTERNER_CHUNK_MAX];
+        /** 字符串数 */
+        std::atomic<NameId> stringNum;
+        /** 当前驻留表(NULL为全局驻留表) */
+        static std::atomic<StringInterner *> current;
+        /**
+         * @brief 存储新字符串
+         * 
+         * @param str 字符串
+         * @return 名称ID与存储后的字符串
+         */
+        std::pair<NameId, std::string_view> Store(std::string_view str);
+    public:
+        /**
+         * @brief StringInterner构造函数
+         * 
+         */
+        StringInterner();
+        /**
+         * @brief StringInterner析构函数
+         * 
+         */
+        ~StringInterner();
+        /**
+         * @brief 删除拷贝构造函数
+         * 
+         * @param other 驻留表
+         */
+        StringInterner(const StringInterner &other) = delete;
+        /**
+         * @brief 驻留字符串
+         * 
+         * 线程安全
+         * 
+         * @param str 字符串
+         * @return 名称ID
+         */
+        NameId Intern(std::string_view str);
+        /**
+         * @brief 获取字符串
+         * 
+         * id须已由Intern返回(本线程, 或经过同步的其他线程)
+         * 
+         * @param id 名称ID
+         * @return 字符串(指向驻留表内部, 不复制)
+         */
+        std::string_view GetString(NameId id) const {
+            return chunks[id >> INTERNER_CHUNK_SHIFT][id & ((1 << INTERNER_CHUNK_SHIFT) - 1)];
+        }
+        /**
+         * @brief 获取字符串数
+         * 
+         * @return 字符串数
+         */
+        const int GetStringNum() const;
+        /**
+         * @brief 获取占用字节数
+         * 
+         * @return 占用字节数
+         */
+        const size_t GetArenaBytes() const;
+        /**
+         * @brief 获取全部占用字节数
+         * 
+         * 驻留表对象, 字符存储, 已分配的ID块与查找表; 查找表的节点按值加一个指针估算
+         * 不应与Intern同时调用
+         * 
+         * @return 占用字节数
+         */
+        const size_t GetReservedBytes() const;
+        /**
+         * @brief 获取全局驻留表
+         * 
+         * @return 全局驻留表
+         */
+        static StringInterner &GetGlobal();
+        /**
+         * @brief 获取当前驻留表
+         * 
+         * 没有InternerScope时为全局驻留表
+         * 
+         * @return 当前驻留表
+         */
+        static StringInterner &GetCurrent() {
+            StringInterner *interner = current.load(std::memory_order_acquire);
+            return interner != NULL ? *interner : GetGlobal();
+        }
+        friend class InternerScope;
+    };
+
+    /**
+     * @brief 驻留表作用域
+     * 
+     * 作用域内Name使用给定的驻留表, 作用域结束后恢复原来的驻留表
+     * 驻留表连同其中的字符串可在作用域结束后整体释放, 不必留在全局驻留表中
+     * 作用域对所有线程生效(线程池中的任务也使用同一驻留表), 须按后进先出嵌套
+     * 在作用域内创建的Name不应在作用域外使用
+     * 
+     */
+    class InternerScope {
+    protected:
+        /** 原来的驻留表 */
+        StringInterner *prev;
+    public:
+        /**
+         * @brief InternerScope构造函数
+         * 
+         * @param interner 驻留表
+         */
+        InternerScope(StringInterner &interner) : prev(StringInterner::current.exchange(&interner, std::memory_order_acq_rel)) {
+        }
+        /**
+         * @brief InternerScope析构函数
+         * 
+         */
+        ~InternerScope() {
+            StringInterner::current.store(prev, std::memory_order_release);
+        }
+        InternerScope(const InternerScope &) = delete;
+        InternerScope &operator=(const InternerScope &) = delete;
+    };
+
+    /**
+     * @brief 名称
+     * 
+     * 当前驻留表(默认为全局驻留表, 见InternerScope)中的字符串句柄
+     * 比较为整数比较, 复制不分配内存
+     * 
+     */
+    class Name {
+    protected:
+        /** 名称ID */
+        NameId id;
+    public:
+        /**
+         * @brief Name构造函数
+         * 
+         * 空名称
+         * 
+         */
+        Name() : id(0) {
+        }
+        /**
+         * @brief Name构造函数
+         * 
+         * @param str 字符串
+         */
+        Name(const char *str) : id(StringInterner::GetCurrent().Intern(str)) {
+        }
+        /**
+         * @brief Name构造函数
+         * 
+         * @param str 字符串
+         */
+        Name(const std::string &str) : id(StringInterner::GetCurrent().Intern(str)) {
+        }
+        /**
+         * @brief Name构造函数
+         * 
+         * @param str 字符串
+         */
+        Name(std::string_view str) : id(StringInterner::GetCurrent().Intern(str)) {
+        }
+        /**
+         * @brief 由ID构造名称
+         * 
+         * @param id 名称ID
+         * @return 名称
+         */
+        static Name FromId(NameId id) {
+            Name name;
+            name.id = id;
+            return name;
+        }
+        /**
+         * @brief 获取名称ID
+         * 
+         * @return 名称ID
+         */
+        const NameId GetId() const {
+            return id;
+        }
+        /**
+         * @brief 获取字符串视图
+         * 
+         * @return 字符串视图
+         */
+        std::string_view View() const {
+            return StringInterner::GetCurrent().GetString(id);
+        }
+        /**
+         * @brief 转字符串
+         * 
+         * @return 字符串
+         */
+        std::string ToString() const {
+            return std::string(View());
+        }
+        /**
+         * @brief 是否为空名称
+         * 
+         * @return 是否为空名称
+         */
+        const bool IsEmpty() const {
+            return id == 0;
+        }
+        /**
+         * @brief 判等
+         * 
+         * @param other 另一个名称
+         * @return 是否相等
+         */
+        bool operator==(const Name &other) const {
+            return id == other.id;
+        }
+        /**
+         * @brief 判不等
+         * 
+         * @param other 另一个名称
+         * @return 是否不等
+         */
+        bool operator!=(const Name &other) const {
+            return id != other.id;
+        }
+        /**
+         * @brief 按ID排序
+         * 
+         * @param other 另一个名称
+         * @return 是否小于
+         */
+        bool operator<(const Name &other) const {
+            return id < other.id;
+        }
+    };
+
+    /**
+     * @brief 输出名称
+     * 
+     * @param outs 输出流
+     * @param name 名称
+     * @return 输出流
+     */
+    inline std::ostream &operator<<(std::ostream &outs, const Name &name) {
+        return outs << name.View();
+    }
+}
+
+namespace std {
+    /**
+     * @brief 名称哈希
+     * 
+     */
+    template<> struct hash<tayir::Name> {
+        size_t operator()(const tayir::Name &name) const {
+            return std::hash<tayir::NameId>()(name.GetId());
+        }
+    };
+}
\ No newline at end of file
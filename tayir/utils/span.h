@@ -0,0 +1,120 @@
+/**
+ * @file span.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 连续内存视图
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace tayir {
+    /**
+     * @brief 连续内存视图
+     * 
+     * 不持有内存, 仅引用一段连续的元素
+     * 
+     * @tparam T 元素类型
+     */
+    template<typename T> class Span {
+    protected:
+        /** 首元素 */
+        T *data;
+        /** 元素数 */
+        size_t size;
+    public:
+        /**
+         * @brief Span构造函数
+         * 
+         * 空视图
+         * 
+         */
+        Span() : data(NULL), size(0) {
+        }
+        /**
+         * @brief Span构造函数
+         * 
+         * @param data 首元素
+         * @param size 元素数
+         */
+        Span(T *data, size_t size) : data(data), size(size) {
+        }
+        /**
+         * @brief Span构造函数
+         * 
+         * 由元素可隐式转换的视图构造(如Span<Ins>转为Span<const Ins>)
+         * 
+         * @tparam U 源元素类型
+         * @param other 源视图
+         */
+        template<typename U> Span(const Span<U> &other) : data(other.GetData()), size(other.GetSize()) {
+        }
+        /**
+         * @brief 获取首元素
+         * 
+         * @return 首元素
+         */
+        T *GetData() const {
+            return data;
+        }
+        /**
+         * @brief 获取元素数
+         * 
+         * @return 元素数
+         */
+        const size_t GetSize() const {
+            return size;
+        }
+        /**
+         * @brief 是否为空
+         * 
+         * @return 是否为空
+         */
+        const bool IsEmpty() const {
+            return size == 0;
+        }
+        /**
+         * @brief 获取元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 下标
+         * @return 元素
+         */
+        T &operator[](size_t sub) const {
+            return data[sub];
+        }
+        /**
+         * @brief 获取子视图
+         * 
+         * @param offset 起始下标
+         * @param count 元素数
+         * @return 子视图
+         */
+        Span<T> SubSpan(size_t offset, size_t count) const {
+            return Span<T>(data + offset, count);
+        }
+        /**
+         * @brief 首迭代器
+         * 
+         * @return 迭代器
+         */
+        T *begin() const {
+            return data;
+        }
+        /**
+         * @brief 尾后迭代器
+         * 
+         * @return 迭代器
+         */
+        T *end() const {
+            return data + size;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file sparseset.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 稀疏集
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <utils/sparseset.h>
+
+#include <cstddef>
+
+namespace tayir {
+    /**
+     * @brief SparseSet构造函数
+     * 
+     * 空集
+     * 
+     * @param capacity 全集大小
+     */
+    SparseSet::SparseSet(int capacity)
+        : capacity(capacity), size(0), dense(new int[capacity]), sparse(new int[capacity])
+    {
+        // 算法本身不要求初始化, 此处清零只为避免读取未初始化内存
+        for (int i = 0 ; i < capacity ; i ++) {
+            sparse[i] = 0;
+        }
+    }
+
+    /**
+     * @brief SparseSet析构函数
+     * 
+     */
+    SparseSet::~SparseSet() {
+        if (dense != NULL) {
+            delete[] dense;
+            dense = NULL;
+        }
+        if (sparse != NULL) {
+            delete[] sparse;
+            sparse = NULL;
+        }
+    }
+}
\ No newline at end of file
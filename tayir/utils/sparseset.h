@@ -0,0 +1,162 @@
+/**
+ * @file sparseset.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 稀疏集
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+namespace tayir {
+    /**
+     * @brief 稀疏集
+     * 
+     * Briggs-Torczon稀疏集, 全集为[0, capacity)
+     * 插入, 删除, 查询与清空均为O(1), 遍历代价与元素数成正比
+     * 适合作为数据流分析的工作表
+     * 
+     */
+    class SparseSet {
+    protected:
+        /** 全集大小 */
+        int capacity;
+        /** 元素数 */
+        int size;
+        /** 稠密数组: 按插入顺序存放元素 */
+        int *dense;
+        /** 稀疏数组: 元素 -> 在稠密数组中的下标 */
+        int *sparse;
+    public:
+        /**
+         * @brief SparseSet构造函数
+         * 
+         * 空集
+         * 
+         * @param capacity 全集大小
+         */
+        SparseSet(int capacity);
+        /**
+         * @brief SparseSet析构函数
+         * 
+         */
+        ~SparseSet();
+        SparseSet(const SparseSet &) = delete;
+        SparseSet &operator=(const SparseSet &) = delete;
+        /**
+         * @brief 获取全集大小
+         * 
+         * @return 全集大小
+         */
+        const int GetCapacity() const {
+            return capacity;
+        }
+        /**
+         * @brief 获取元素数
+         * 
+         * @return 元素数
+         */
+        const int GetSize() const {
+            return size;
+        }
+        /**
+         * @brief 是否为空
+         * 
+         * @return 是否为空
+         */
+        const bool IsEmpty() const {
+            return size == 0;
+        }
+        /**
+         * @brief 是否包含元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 元素
+         * @return 是否包含
+         */
+        const bool Contains(int sub) const {
+            int pos = sparse[sub];
+            return pos < size && dense[pos] == sub;
+        }
+        /**
+         * @brief 加入元素
+         * 
+         * 不做边界检查
+         * 
+         * @param sub 元素
+         * @return 是否新加入
+         */
+        bool Insert(int sub) {
+            if (Contains(sub)) {
+                return false;
+            }
+            sparse[sub] = size;
+            dense[size ++] = sub;
+            return true;
+        }
+        /**
+         * @brief 移除元素
+         * 
+         * 用最后一个元素填补空位, 会改变遍历顺序
+         * 
+         * @param sub 元素
+         * @return 是否被移除
+         */
+        bool Erase(int sub) {
+            if (! Contains(sub)) {
+                return false;
+            }
+            int last = dense[-- size];
+            dense[sparse[sub]] = last;
+            sparse[last] = sparse[sub];
+            return true;
+        }
+        /**
+         * @brief 取出最后加入的元素
+         * 
+         * 集合须非空
+         * 
+         * @return 元素
+         */
+        int Pop() {
+            return dense[-- size];
+        }
+        /**
+         * @brief 清空
+         * 
+         */
+        void Clear() {
+            size = 0;
+        }
+        /**
+         * @brief 获取元素
+         * 
+         * @param sub 稠密数组下标
+         * @return 元素
+         */
+        int operator[](int sub) const {
+            return dense[sub];
+        }
+        /**
+         * @brief 首迭代器
+         * 
+         * @return 迭代器
+         */
+        const int *begin() const {
+            return dense;
+        }
+        /**
+         * @brief 尾后迭代器
+         * 
+         * @return 迭代器
+         */
+        const int *end() const {
+            return dense + size;
+        }
+    };
+}
\ No newline at end of file
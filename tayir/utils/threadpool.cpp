@@ -0,0 +1,136 @@
+/**
+ * @file threadpool.cpp
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 线程池
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#include <utils/threadpool.h>
+
+namespace tayir {
+    /**
+     * @brief ThreadPool构造函数
+     * 
+     * @param threadNum 线程数(包括调用线程, 不大于0时取硬件线程数)
+     */
+    ThreadPool::ThreadPool(int threadNum)
+        : task(NULL), taskNum(0), nextTask(0), busyNum(0), generation(0), stopping(false)
+    {
+        if (threadNum <= 0) {
+            threadNum = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threadNum - 1);
+        for (int i = 1 ; i < threadNum ; i ++) {
+            workers.emplace_back(&ThreadPool::WorkerMain, this);
+        }
+    }
+
+    /**
+     * @brief ThreadPool析构函数
+     * 
+     */
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief 领取并执行任务, 直到没有剩余任务
+     * 
+     */
+    void ThreadPool::Drain() {
+        while (true) {
+            const int sub = nextTask.fetch_add(1, std::memory_order_relaxed);
+            if (sub >= taskNum) {
+                return;
+            }
+            try {
+                (*task)(sub);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (! error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 工作线程主循环
+     * 
+     */
+    void ThreadPool::WorkerMain() {
+        int seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wakeup.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            Drain();
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                busyNum --;
+            }
+            finished.notify_one();
+        }
+    }
+
+    /**
+     * @brief 获取线程数
+     * 
+     * @return 线程数(包括调用线程)
+     */
+    const int ThreadPool::GetThreadNum() const {
+        return workers.size() + 1;
+    }
+
+    /**
+     * @brief 并行执行task(0) ~ task(num - 1)
+     * 
+     * 阻塞到全部任务完成
+     * 任务抛出异常时, 其余已领取的任务照常完成, 之后在调用线程重新抛出第一个异常
+     * 
+     * @param num 任务数
+     * @param task 任务
+     */
+    void ThreadPool::Run(int num, const std::function<void(int)> &task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            this->task = &task;
+            taskNum = num;
+            nextTask.store(0, std::memory_order_relaxed);
+            busyNum = workers.size();
+            error = NULL;
+            generation ++;
+        }
+        wakeup.notify_all();
+        Drain();
+        std::exception_ptr thrown;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&] { return busyNum == 0; });
+            this->task = NULL;
+            thrown = error;
+            error = NULL;
+        }
+        if (thrown) {
+            std::rethrow_exception(thrown);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file threadpool.h
+ * @author theflysong (song_of_the_fly@163.com)
+ * @brief 线程池
+ * @version alpha-1.0.0
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2022 TayhuangOS Development Team
+ * SPDX-License-Identifier: LGPL-2.1-only
+ * 
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tayir {
+    /**
+     * @brief 线程池
+     * 
+     * 固定数量的工作线程, 以并行for的形式分发任务
+     * 调用线程也参与执行, 因此threadNum为1时不创建工作线程
+     * 
+     */
+    class ThreadPool {
+    protected:
+        /** 工作线程 */
+        std::vector<std::thread> workers;
+        /** 锁 */
+        std::mutex lock;
+        /** 新任务/退出通知 */
+        std::condition_variable wakeup;
+        /** 任务完成通知 */
+        std::condition_variable finished;
+        /** 当前任务 */
+        const std::function<void(int)> *task;
+        /** 任务数 */
+        int taskNum;
+        /** 下一个待领取的任务 */
+        std::atomic<int> nextTask;
+        /** 仍在执行当前任务的工作线程数 */
+        int busyNum;
+        /** 任务批次(每次Run加1) */
+        int generation;
+        /** 是否退出 */
+        bool stopping;
+        /** 第一个异常 */
+        std::exception_ptr error;
+        /**
+         * @brief 领取并执行任务, 直到没有剩余任务
+         * 
+         */
+        void Drain();
+        /**
+         * @brief 工作线程主循环
+         * 
+         */
+        void WorkerMain();
+    public:
+        /**
+         * @brief ThreadPool构造函数
+         * 
+         * @param threadNum 线程数(包括调用线程, 不大于0时取硬件线程数)
+         */
+        ThreadPool(int threadNum);
+        /**
+         * @brief ThreadPool析构函数
+         * 
+         */
+        ~ThreadPool();
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        /**
+         * @brief 获取线程数
+         * 
+         * @return 线程数(包括调用线程)
+         */
+        const int GetThreadNum() const;
+        /**
+         * @brief 并行执行task(0) ~ task(num - 1)
+         * 
+         * 阻塞到全部任务完成
+         * 任务抛出异常时, 其余已领取的任务照常完成, 之后在调用线程重新抛出第一个异常
+         * 
+         * @param num 任务数
+         * @param task 任务
+         */
+        void Run(int num, const std::function<void(int)> &task);
+    };
+}
\ No newline at end of file